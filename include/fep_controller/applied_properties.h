@@ -0,0 +1,87 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <fep_controller/fep_controller_export.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        namespace detail
+        {
+            struct AppliedPropertiesData;
+            struct AppliedPropertiesAccess;
+        }
+
+        /**
+         * Remembers which properties the controller has applied to the participants of a system.
+         *
+         * If passed to @ref configureSystemProperties via @ref ConfigureOptions::_applied_properties
+         * only properties which changed or were added since the last call are pushed to the participants.
+         * The system is only brought to the loaded state and the timing is only configured
+         * on the first call (or if the timing properties changed).
+         *
+         * The controller can not notice changes made to the participants by others
+         * (e.g. a restarted participant). Call @ref clear in that case to push all properties again.
+         *
+         * @remark An instance must not be used by concurrent configure calls.
+         */
+        class FEP3_CONTROLLER_EXPORT AppliedProperties
+        {
+        public:
+            /// CTOR
+            AppliedProperties();
+            /// DTOR
+            ~AppliedProperties();
+            /// move CTOR
+            AppliedProperties(AppliedProperties&& other);
+            /// move assignment
+            AppliedProperties& operator=(AppliedProperties&& other);
+            AppliedProperties(const AppliedProperties&) = delete;
+            AppliedProperties& operator=(const AppliedProperties&) = delete;
+
+            /**
+             * Forgets everything, the next configure call pushes all properties again.
+             */
+            void clear();
+            /**
+             * Forgets what was applied to the participant @p participant_name.
+             *
+             * @param [in] participant_name the name of the participant
+             */
+            void clear(const std::string& participant_name);
+            /**
+             * @return true if nothing has been applied yet
+             */
+            bool empty() const;
+            /**
+             * @param [in] participant_name the name of the participant
+             * @return the number of properties (system and participant properties) applied to the participant
+             */
+            size_t getPropertyCount(const std::string& participant_name) const;
+
+        private:
+            friend struct detail::AppliedPropertiesAccess;
+            std::unique_ptr<detail::AppliedPropertiesData> _data;
+        };
+    } // namespace controller
+} // namespace fep3
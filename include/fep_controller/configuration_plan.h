@@ -0,0 +1,89 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fep_controller/fep_controller_export.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * The requests @ref configureSystemProperties sends to one participant
+         */
+        struct PlannedParticipant
+        {
+            /// name of the participant
+            std::string _participant_name;
+            /// number of system properties to set, 0 if the "/system" node is not accessed at all
+            size_t _system_property_count = 0;
+            /// number of element instance properties to set, 0 if the "/" node is not accessed at all
+            size_t _element_property_count = 0;
+            /// true if the properties are set by a batch writer (one request per node), planned from
+            /// whether a writer factory is set, the writer is only created when the plan is executed.
+            /// If no writer is created then, the participant is replanned unbatched.
+            bool _batched = false;
+            /// true if the system properties are broadcast (see @ref ConfigureOptions::_broadcast_system_properties)
+            bool _broadcast = false;
+            /// number of requests to the participant (node access and property writes)
+            size_t _round_trips = 0;
+            /// the wave the participant is configured in (see @ref ConfigureOptions::_priority_waves)
+            size_t _wave = 0;
+        };
+
+        /**
+         * The steps of a @ref configureSystemProperties call, planned from the parsed properties file
+         * before any participant is contacted.
+         * Participants without anything to set are not contacted at all.
+         */
+        struct ConfigurationPlan
+        {
+            /// name of the system
+            std::string _system_name;
+            /// true if the system is brought to the loaded state first
+            bool _load_system = false;
+            /// the planned requests, one entry per participant of the system
+            std::vector<PlannedParticipant> _participants;
+            /// number of waves the participants are configured in, one after another
+            size_t _wave_count = 1;
+            /// true if the timing is configured at the end
+            bool _configure_timing = false;
+            /// the timing_configuration_type of the properties file
+            std::string _timing_configuration_type;
+        };
+
+        /**
+         * @param [in] plan the plan
+         * @return the number of requests to the participants for setting the properties
+         *         (the state transition and the timing configuration are not included)
+         */
+        size_t FEP3_CONTROLLER_EXPORT getRoundTripCount(const ConfigurationPlan& plan);
+
+        /**
+         * Writes @p plan in a human readable form, one step per line
+         *
+         * @param [in] plan the plan to write
+         * @param [in] stream the stream to write to
+         */
+        void FEP3_CONTROLLER_EXPORT writeConfigurationPlan(const ConfigurationPlan& plan, std::ostream& stream);
+    } // namespace controller
+} // namespace fep3
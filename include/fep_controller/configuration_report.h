@@ -0,0 +1,94 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fep_controller/fep_controller_export.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * The step of @ref configureSystemProperties which failed
+         */
+        enum class ConfigurationStep
+        {
+            /// bringing the system to the loaded state
+            system_state,
+            /// setting a property of a participant
+            property,
+            /// configuring the timing of the system
+            timing
+        };
+
+        /**
+         * A failed item of @ref configureSystemProperties
+         */
+        struct ConfigurationFailure
+        {
+            /// the step which failed
+            ConfigurationStep _step = ConfigurationStep::property;
+            /// the participant, empty for the steps of the whole system
+            std::string _participant_name;
+            /// the property node ("/" or "/system"), empty for the steps of the whole system
+            std::string _node_path;
+            /// name of the property as within the properties file, empty for the steps of the whole system
+            std::string _property_name;
+            /// type of the property
+            std::string _type;
+            /// value of the property
+            std::string _value;
+            /// why the item failed
+            std::string _reason;
+        };
+
+        /**
+         * All failures of a @ref configureSystemProperties call collecting its failures
+         * (see @ref ConfigureOptions::_report).
+         * If a participant can not be accessed at all, every property to set on it is reported.
+         */
+        struct ConfigurationReport
+        {
+            /// name of the configured system
+            std::string _system_name;
+            /// the failed items, the failures of the participants in the order of the system
+            std::vector<ConfigurationFailure> _failures;
+        };
+
+        /**
+         * @param [in] report the report to look into
+         *
+         * @return the names of the participants with a failed system property within @p report,
+         *         in the order of the report
+         */
+        std::vector<std::string> FEP3_CONTROLLER_EXPORT getParticipantsMissingSystemProperties(
+            const ConfigurationReport& report);
+
+        /**
+         * Writes @p report in a human readable form, one failure per line
+         *
+         * @param [in] report the report to write
+         * @param [in] stream the stream to write to
+         */
+        void FEP3_CONTROLLER_EXPORT writeConfigurationReport(const ConfigurationReport& report, std::ostream& stream);
+    } // namespace controller
+} // namespace fep3
@@ -0,0 +1,156 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <fep_controller/fep_controller_export.h>
+#include <fep_controller/fep_controller.h>
+#include <fep_controller/property_overlay.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        namespace detail
+        {
+            struct ControllerData;
+        }
+
+        /**
+         * A session controlling one FEP System from the connect to the teardown.
+         *
+         * Unlike the free functions, which start from scratch on every call, the session keeps
+         * what it learned about the system between its steps:
+         * the parsed system sdk description and system properties file, the resolved file references
+         * of the participants (see @ref ResolvedPaths), the configuration RPC proxies of the participants
+         * and the properties applied to them (see @ref AppliedProperties).
+         * A @ref reconfigure therefore only contacts the participants whose properties changed.
+         *
+         * @remark An instance must not be used by concurrent calls.
+         */
+        class FEP3_CONTROLLER_EXPORT Controller
+        {
+        public:
+            /// CTOR, the controller is not connected
+            Controller();
+            /// DTOR, releases the system without changing the state of its participants
+            ~Controller();
+            /// move CTOR
+            Controller(Controller&& other);
+            /// move assignment
+            Controller& operator=(Controller&& other);
+            Controller(const Controller&) = delete;
+            Controller& operator=(const Controller&) = delete;
+
+            /**
+             * Connects to the FEP System defined by a system sdk description (see @ref connectSystem).
+             * @ref ConnectOptions::_resolved_paths is not used, the session resolves the file references
+             * through its own @ref getResolvedPaths.
+             *
+             * @param [in] system_sdk_description_file The filepath to the system sdk description file
+             * @param [in] options The options to use
+             *
+             * @throws std::runtime_error if the controller is already connected
+             *                            if @p system_sdk_description_file can not be found or read
+             *                            if the data model can not be created from @p system_sdk_description_file
+             * @throws OperationCancelledError if the connect was cancelled
+             */
+            void connect(const std::string& system_sdk_description_file,
+                         const ConnectOptions& options = ConnectOptions());
+
+            /**
+             * Sets all properties configured by @p system_properties_file for the connected system
+             * (see @ref configureSystemProperties), no matter what was applied before.
+             * @ref ConfigureOptions::_applied_properties is not used, the session records the applied
+             * properties within its own @ref getAppliedProperties (not for a dry run or a retry).
+             * As everything is pushed, @ref ConfigureOptions::_broadcast_system_properties is used if set.
+             *
+             * @param [in] system_properties_file The filepath to the system properties file
+             * @param [in] options The options to use
+             *
+             * @throws std::runtime_error if the controller is not connected
+             *                            see @ref configureSystemProperties for the other failures
+             */
+            void configure(const std::string& system_properties_file,
+                           const ConfigureOptions& options = ConfigureOptions());
+
+            /**
+             * Sets the properties configured by @p system_properties_file for the connected system
+             * which changed or were added since the last @ref configure or @ref reconfigure.
+             * Behaves like @ref configure if nothing was applied yet.
+             *
+             * @param [in] system_properties_file The filepath to the system properties file
+             * @param [in] options The options to use
+             *
+             * @throws std::runtime_error if the controller is not connected
+             *                            see @ref configureSystemProperties for the other failures
+             */
+            void reconfigure(const std::string& system_properties_file,
+                             const ConfigureOptions& options = ConfigureOptions());
+
+            /**
+             * Sets the properties of the last @ref configure or @ref reconfigure with @p overlay applied
+             * (see @ref applyPropertyOverlay). The parsed properties of that call are the base,
+             * only the properties differing from what was applied before are pushed.
+             * Overridden properties of the base fall back to their base value once an overlay no longer
+             * overrides them. Properties and element instances added by an overlay are not within the base,
+             * they keep their last value at the participants and are not reverted.
+             *
+             * @param [in] overlay The overrides of the base properties
+             * @param [in] options The options to use
+             *
+             * @throws std::runtime_error if the controller is not connected or was not configured yet
+             *                            see @ref applyPropertyOverlay for the other failures
+             */
+            void applyOverlay(const PropertyOverlay& overlay,
+                              const ConfigureOptions& options = ConfigureOptions());
+
+            /**
+             * Brings the participants of the connected system to the unloaded state and releases
+             * the system and everything kept about it. Does nothing if the controller is not connected.
+             * The controller is not connected afterwards, even if the state transition failed.
+             *
+             * @throws std::runtime_error if the participants can not be brought to the unloaded state
+             */
+            void teardown();
+
+            /**
+             * @return true if the controller is connected to a system
+             */
+            bool isConnected() const;
+            /**
+             * @return the connected system
+             * @throws std::runtime_error if the controller is not connected
+             */
+            fep3::System& getSystem();
+            /**
+             * @return the file references resolved by the last @ref connect
+             */
+            const ResolvedPaths& getResolvedPaths() const;
+            /**
+             * @return the properties applied by @ref configure and @ref reconfigure
+             */
+            const AppliedProperties& getAppliedProperties() const;
+
+        private:
+            std::unique_ptr<detail::ControllerData> _data;
+        };
+    } // namespace controller
+} // namespace fep3
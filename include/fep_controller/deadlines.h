@@ -0,0 +1,84 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include <fep_controller/fep_controller_export.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * Time limits of a configure operation, 0 means no limit (default).
+         *
+         * The limits are checked before every request to a participant. While a limit is set,
+         * the requests run on a thread of their own and the controller waits for them at most
+         * until the request limit or the participant or operation limit expires. A request not
+         * returning in time is abandoned and fails with @ref DeadlineExceededError. It is not
+         * retried, since requests like loading a participant or setting its properties must not
+         * be sent twice. The request can not be interrupted, it keeps running in the background
+         * until it returns and keeps the access to the participant alive until then.
+         * A failed request is only retried if at least the request limit is left of the other limits.
+         */
+        struct DeadlineOptions
+        {
+            /// the whole operation, also limits the state transition to loaded
+            std::chrono::milliseconds _operation_deadline{ 0 };
+            /// all requests to one participant, including their retries
+            std::chrono::milliseconds _participant_deadline{ 0 };
+            /// a single request to a participant, the time needed to start a retry
+            std::chrono::milliseconds _request_deadline{ 0 };
+        };
+
+        /**
+         * Retries of requests to a participant which failed transiently
+         * (the request threw). A property refused by the participant is not retried,
+         * neither is an abandoned request nor a request if less than @ref DeadlineOptions::_request_deadline is left
+         * of the participant or operation deadline.
+         *
+         * The n-th retry waits a random time between the half and the full backoff of
+         * min(_initial_backoff * _backoff_multiplier^(n-1), _max_backoff).
+         */
+        struct RetryOptions
+        {
+            /// number of retries of a request, 0 does not retry (default)
+            size_t _max_retries = 0;
+            /// backoff before the first retry
+            std::chrono::milliseconds _initial_backoff{ 10 };
+            /// upper bound of the backoff
+            std::chrono::milliseconds _max_backoff{ 1000 };
+            /// growth of the backoff from retry to retry
+            double _backoff_multiplier = 2.0;
+        };
+
+        /**
+         * Thrown if a limit of @ref DeadlineOptions was exceeded
+         */
+        class FEP3_CONTROLLER_EXPORT DeadlineExceededError : public std::runtime_error
+        {
+        public:
+            /// CTOR
+            explicit DeadlineExceededError(const std::string& what);
+        };
+    } // namespace controller
+} // namespace fep3
@@ -0,0 +1,80 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <fep_controller/fep_controller_export.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * The default memory limit of the description cache in bytes
+         */
+        constexpr size_t description_cache_default_memory_limit = 64 * 1024 * 1024;
+
+        /**
+         * Statistics of the description cache
+         */
+        struct DescriptionCacheStatistics
+        {
+            /// number of cached files
+            size_t _entries = 0;
+            /// estimated memory used by the cached descriptions in bytes
+            size_t _memory_usage = 0;
+            /// the memory limit in bytes
+            size_t _memory_limit = 0;
+            /// number of loads served from the cache
+            uint64_t _hits = 0;
+            /// number of loads which had to parse the file
+            uint64_t _misses = 0;
+        };
+
+        /**
+         * Sets the memory limit of the process wide description cache.
+         *
+         * @ref connectSystem and @ref configureSystemProperties keep the parsed system sdk description
+         * and system properties files within this cache. A file is parsed again if its canonical path,
+         * size or modification time changed. If the limit is exceeded the least recently used files are dropped.
+         *
+         * @param [in] memory_limit the limit in bytes, 0 disables the cache
+         *                          (default: @ref description_cache_default_memory_limit)
+         */
+        void FEP3_CONTROLLER_EXPORT setDescriptionCacheLimit(size_t memory_limit);
+
+        /**
+         * Drops all files from the description cache.
+         */
+        void FEP3_CONTROLLER_EXPORT invalidateDescriptionCache();
+
+        /**
+         * Drops the file @p file_path from the description cache.
+         *
+         * @param [in] file_path the path of the system sdk description or system properties file
+         */
+        void FEP3_CONTROLLER_EXPORT invalidateDescriptionCache(const std::string& file_path);
+
+        /**
+         * @return the current statistics of the description cache
+         */
+        DescriptionCacheStatistics FEP3_CONTROLLER_EXPORT getDescriptionCacheStatistics();
+    } // namespace controller
+} // namespace fep3
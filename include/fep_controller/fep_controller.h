@@ -17,17 +17,181 @@
  */
 #pragma once
 
+#include <future>
 #include <string>
 
 #include <fep_system/fep_system.h>
 #include <fep_controller/fep_controller_export.h>
+#include <fep_controller/applied_properties.h>
+#include <fep_controller/configuration_plan.h>
+#include <fep_controller/configuration_report.h>
+#include <fep_controller/deadlines.h>
+#include <fep_controller/description_cache.h>
+#include <fep_controller/progress.h>
+#include <fep_controller/property_export.h>
+#include <fep_controller/resolved_paths.h>
+#include <fep_controller/snapshot.h>
+#include <fep_controller/tracing.h>
+#include <fep_controller/property_batch_writer_intf.h>
+#include <fep_controller/system_access_intf.h>
 
 namespace fep3
 {   
     namespace controller
     {
         /**
-         * Connects to a FEP System defined by a system sdk description
+         * Default size in bytes from which on system properties files are parsed by the streaming parser
+         */
+        constexpr size_t streaming_parse_default_threshold = 16 * 1024 * 1024;
+
+        /**
+         * Options to tune how @ref configureSystemProperties talks to the participants of a system
+         */
+        struct ConfigureOptions
+        {
+            /**
+             * Number of participants configured concurrently.
+             * 0 or 1 configures the participants one after another (default).
+             */
+            size_t _worker_count = 1;
+            /**
+             * If true, the participants are configured in waves of equal init priority,
+             * the wave with the highest init priority first (the order a fep3::System initializes them in).
+             * The participants of a wave are configured concurrently by up to @ref _worker_count workers,
+             * a wave starts once the previous one is configured completely.
+             * If false (default), all participants are configured in one wave in the order of the system.
+             */
+            bool _priority_waves = false;
+            /**
+             * Factory for the batch writers used to set all properties of a participant within one request.
+             * If not set, or if the factory returns no writer for a participant,
+             * the properties are set one by one via the configuration RPC service.
+             * Not used for an @ref ISystemAccess, which provides the batch writers itself.
+             */
+            PropertyBatchWriterFactory _batch_writer_factory;
+            /**
+             * If set, only properties which changed since the last call with the same object are pushed
+             * (see @ref AppliedProperties). The object is updated with every property successfully applied.
+             */
+            AppliedProperties* _applied_properties = nullptr;
+            /**
+             * System properties files of at least this size (in bytes) are parsed from the xml event stream
+             * without building a DOM of the whole file first. This keeps the peak memory close to the size
+             * of the parsed content. 0 streams every file.
+             */
+            size_t _streaming_parse_threshold = streaming_parse_default_threshold;
+            /**
+             * If set, called for every participant reaching @ref ProgressStage::loaded,
+             * @ref ProgressStage::configured and @ref ProgressStage::timing_applied
+             * and once the properties file is @ref ProgressStage::parsed.
+             */
+            ProgressCallback _progress_callback;
+            /**
+             * Checked before every participant operation, the configuration stops with
+             * @ref OperationCancelledError once it is cancelled.
+             * Participants already configured keep their properties.
+             */
+            CancellationToken _cancellation_token;
+            /**
+             * If set, receives the plan of the requests to the participants.
+             * The plan is made from the parsed properties file before any participant is contacted.
+             * It is updated if a participant does not provide the batch writer it was planned with.
+             */
+            ConfigurationPlan* _plan = nullptr;
+            /**
+             * If true, only the plan is made (see @ref _plan and @ref writeConfigurationPlan),
+             * the system and its participants are not changed.
+             */
+            bool _dry_run = false;
+            /**
+             * If set, failures of single participants and properties do not stop the configuration.
+             * All reachable participants are configured and every failure is recorded within the report
+             * (which is cleared first). A failed state transition or timing configuration is recorded as well.
+             * A cancellation still throws @ref OperationCancelledError.
+             */
+            ConfigurationReport* _report = nullptr;
+            /**
+             * If set, only the items which failed within this report are configured again
+             * with the values of the properties file: the failed properties and,
+             * if they failed, the state transition and the timing configuration.
+             * @ref _applied_properties is not used for such a retry.
+             * The report may be the same object as @ref _report.
+             */
+            const ConfigurationReport* _retry_report = nullptr;
+            /**
+             * Time limits of the operation, the participants and the single requests.
+             * A participant exceeding its limit fails with @ref DeadlineExceededError
+             * (recorded within @ref _report if set), the other participants are not held up by it
+             * if @ref _worker_count allows to configure them concurrently.
+             */
+            DeadlineOptions _deadlines;
+            /**
+             * Retries of requests to the participants which failed transiently
+             */
+            RetryOptions _retry;
+            /**
+             * If true, the system is not brought to the loaded state as a whole.
+             * Every participant is loaded by its worker right before its properties are set,
+             * so its configuration does not wait for the other participants to be loaded.
+             * A participant failing to load is recorded within @ref _report (if set)
+             * as failed @ref ConfigurationStep::system_state together with its properties.
+             * If false (default), all participants have to reach the loaded state before the first one is configured.
+             */
+            bool _load_participants = false;
+            /**
+             * If true, the system properties are broadcast: they are serialized once per batch writer type
+             * (see @ref IPropertyBatchWriter::serialize) and sent to every participant within one batched request,
+             * within the wave of the participant (see @ref _priority_waves) before its element properties are set.
+             * Participants without a batch writer get them one by one.
+             * A participant which did not apply all of them (also if it refused one) fails,
+             * see @ref getParticipantsMissingSystemProperties for the participants recorded within @ref _report.
+             * The participant deadline applies to the broadcast and to the element properties separately.
+             * Only used when all system properties are set: not for @ref _retry_report, and for
+             * @ref _applied_properties only if no participant has any of them recorded (e.g. Controller::configure).
+             */
+            bool _broadcast_system_properties = false;
+        };
+
+        /**
+         * Options to observe, cancel and share the path resolution of @ref connectSystem
+         */
+        struct ConnectOptions
+        {
+            /**
+             * If set, called once the description file is @ref ProgressStage::parsed
+             * and for every participant @ref ProgressStage::connected.
+             */
+            ProgressCallback _progress_callback;
+            /**
+             * Checked before every participant is added, the connect stops with
+             * @ref OperationCancelledError once it is cancelled.
+             */
+            CancellationToken _cancellation_token;
+            /**
+             * If set, the file references of the participants are resolved through this object
+             * and stay available after the connect. Otherwise they are resolved through an object
+             * which only lives for the connect call.
+             */
+            ResolvedPaths* _resolved_paths = nullptr;
+        };
+
+        /**
+         * Options of @ref bringUpSystem
+         */
+        struct BringUpOptions
+        {
+            /// the options of the connect
+            ConnectOptions _connect_options;
+            /**
+             * The options of the configuration.
+             * @ref ConfigureOptions::_load_participants is always set by @ref bringUpSystem.
+             */
+            ConfigureOptions _configure_options;
+        };
+
+        /**
+         * Connects to a FEP System defined by a system sdk description.
+         * The description may be a snapshot (see @ref snapshot_file_extension).
          *
          * @param [in] system_sdk_description_file The filepath to the system sdk description file
          *
@@ -38,7 +202,34 @@ namespace fep3
         fep3::System FEP3_CONTROLLER_EXPORT connectSystem(const std::string& system_sdk_description_file);
 
         /**
-         * Sets the properties configured by @p system_properties_file for the @p system 
+         * Connects to a FEP System defined by a system sdk description using the given @p options
+         *
+         * @param [in] system_sdk_description_file The filepath to the system sdk description file
+         * @param [in] options The options to use
+         *
+         * @return Returns the connected system
+         * @throws std::runtime_error if @p system_sdk_description_file can not be found or read
+         *                            if the data model can not be created from @p system_sdk_description_file
+         * @throws OperationCancelledError if the connect was cancelled
+         */
+        fep3::System FEP3_CONTROLLER_EXPORT connectSystem(const std::string& system_sdk_description_file,
+                                                          const ConnectOptions& options);
+
+        /**
+         * Runs @ref connectSystem on a separate thread
+         *
+         * @param [in] system_sdk_description_file The filepath to the system sdk description file
+         * @param [in] options The options to use
+         *
+         * @return Returns the future of the connected system,
+         *         it rethrows the errors of @ref connectSystem on get()
+         */
+        std::future<fep3::System> FEP3_CONTROLLER_EXPORT connectSystemAsync(const std::string& system_sdk_description_file,
+                                                                            ConnectOptions options = ConnectOptions());
+
+        /**
+         * Sets the properties configured by @p system_properties_file for the @p system.
+         * The properties file may be a snapshot (see @ref snapshot_file_extension).
          *
          * @param [in] system The system for which the properties should be set
          * @param [in] system_properties_file The filepath to the system properties file
@@ -50,5 +241,78 @@ namespace fep3
          */
         void FEP3_CONTROLLER_EXPORT configureSystemProperties(fep3::System& system,
                                                              const std::string& system_properties_file);
+
+        /**
+         * Sets the properties configured by @p system_properties_file for the @p system 
+         * using the given @p options.
+         * The per participant work (accessing the configuration and setting the properties)
+         * is distributed over @ref ConfigureOptions::_worker_count threads.
+         * The system timing is configured after all participants have been configured.
+         *
+         * @param [in] system The system for which the properties should be set
+         * @param [in] system_properties_file The filepath to the system properties file
+         * @param [in] options The options to use
+         *
+         * @throws std::runtime_error if @p system_properties_file can not be found or read
+         *                            if the data model can not be created from @p system_properties_file
+         *                            if the system @p system is not is state FS_IDLE 
+         *                            if a participant can not be reached
+         *                            (if several participants fail, the error of the first one
+         *                             within the participant list is reported)
+         *                            these failures are recorded instead if @ref ConfigureOptions::_report is set
+         *                            if @ref ConfigureOptions::_retry_report belongs to another system
+         */
+        void FEP3_CONTROLLER_EXPORT configureSystemProperties(fep3::System& system,
+                                                             const std::string& system_properties_file,
+                                                             const ConfigureOptions& options);
+
+        /**
+         * Sets the properties configured by @p system_properties_file for the participants
+         * accessed through @p system using the given @p options.
+         * Behaves like the overload for a fep3::System, all communication goes through @p system.
+         *
+         * @param [in] system The access to the system for which the properties should be set
+         * @param [in] system_properties_file The filepath to the system properties file
+         * @param [in] options The options to use
+         *
+         * @throws std::runtime_error see @ref configureSystemProperties
+         */
+        void FEP3_CONTROLLER_EXPORT configureSystemProperties(ISystemAccess& system,
+                                                             const std::string& system_properties_file,
+                                                             const ConfigureOptions& options);
+
+        /**
+         * Connects to a FEP System and sets its properties in one go,
+         * what @ref connectSystem followed by @ref configureSystemProperties does.
+         * The system properties file is parsed while the system sdk description is parsed and the system connected.
+         * The participants are loaded one by one (see @ref ConfigureOptions::_load_participants),
+         * each participant is configured as soon as it is loaded.
+         *
+         * @param [in] system_sdk_description_file The filepath to the system sdk description file
+         * @param [in] system_properties_file The filepath to the system properties file
+         * @param [in] options The options to use
+         *
+         * @return Returns the connected and configured system
+         * @throws std::runtime_error see @ref connectSystem and @ref configureSystemProperties
+         * @throws OperationCancelledError if the bring-up was cancelled
+         */
+        fep3::System FEP3_CONTROLLER_EXPORT bringUpSystem(const std::string& system_sdk_description_file,
+                                                          const std::string& system_properties_file,
+                                                          const BringUpOptions& options = BringUpOptions());
+
+        /**
+         * Runs @ref configureSystemProperties on a separate thread.
+         * The @p system must neither be destroyed nor used otherwise until the future is ready.
+         *
+         * @param [in] system The system for which the properties should be set
+         * @param [in] system_properties_file The filepath to the system properties file
+         * @param [in] options The options to use
+         *
+         * @return Returns the future of the configuration,
+         *         it rethrows the errors of @ref configureSystemProperties on get()
+         */
+        std::future<void> FEP3_CONTROLLER_EXPORT configureSystemPropertiesAsync(fep3::System& system,
+                                                                                const std::string& system_properties_file,
+                                                                                ConfigureOptions options = ConfigureOptions());
     } // namespace controller
 } // namespace fep
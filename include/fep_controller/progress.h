@@ -0,0 +1,99 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <fep_controller/fep_controller_export.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * The stages reported while connecting and configuring a system
+         */
+        enum class ProgressStage
+        {
+            /// the description file was parsed (reported once, without participant name)
+            parsed,
+            /// the participant was added to the system
+            connected,
+            /// the participant reached the loaded state
+            loaded,
+            /// the properties of the participant were set
+            configured,
+            /// the system timing was applied to the participant
+            timing_applied
+        };
+
+        /**
+         * Called for every progress step.
+         * The calls are serialized by the controller, but might come from worker threads.
+         *
+         * @param [in] stage the reached stage
+         * @param [in] participant_name the participant which reached the stage (empty for @ref ProgressStage::parsed)
+         */
+        using ProgressCallback = std::function<void(ProgressStage stage, const std::string& participant_name)>;
+
+        /**
+         * Token to cancel a running connect or configure operation.
+         * Copies share the same state, so a copy given to an operation can be cancelled by the original.
+         * The operation checks the token between participant operations and throws
+         * @ref OperationCancelledError if it was cancelled.
+         */
+        class CancellationToken
+        {
+        public:
+            /// CTOR
+            CancellationToken()
+                : _cancelled(std::make_shared<std::atomic<bool>>(false))
+            {
+            }
+
+            /// requests the cancellation of all operations using this token
+            void cancel()
+            {
+                *_cancelled = true;
+            }
+
+            /// @return true if the cancellation was requested
+            bool isCancelled() const
+            {
+                return *_cancelled;
+            }
+
+        private:
+            std::shared_ptr<std::atomic<bool>> _cancelled;
+        };
+
+        /**
+         * Thrown by an operation which was cancelled via its @ref CancellationToken
+         */
+        class FEP3_CONTROLLER_EXPORT OperationCancelledError : public std::runtime_error
+        {
+        public:
+            /// CTOR
+            explicit OperationCancelledError(const std::string& what);
+        };
+    } // namespace controller
+} // namespace fep3
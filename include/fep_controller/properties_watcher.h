@@ -0,0 +1,124 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <fep_controller/fep_controller_export.h>
+#include <fep_controller/fep_controller.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        namespace detail
+        {
+            struct PropertiesWatcherData;
+        }
+
+        /**
+         * Called after every reload of a watched system properties file
+         *
+         * @param [in] error_message empty if the changes were applied, the error otherwise
+         */
+        using ReloadCallback = std::function<void(const std::string& error_message)>;
+
+        /**
+         * Options of a @ref PropertiesWatcher
+         */
+        struct WatchOptions
+        {
+            /// the time the file has to stay unchanged after a change before it is reloaded
+            std::chrono::milliseconds _debounce{ 100 };
+            /// the polling interval of the file on platforms without file system notifications
+            std::chrono::milliseconds _poll_interval{ 250 };
+            /**
+             * The options of the reconfiguration.
+             * If @ref ConfigureOptions::_applied_properties is set, the changes are determined against it
+             * (and it is updated by every reload), otherwise against the content of the file when the watch started.
+             */
+            ConfigureOptions _configure_options;
+            /// if set, called from the watching thread after every reload
+            ReloadCallback _reload_callback;
+        };
+
+        /**
+         * Watches a system properties file and pushes the changed values to an already configured system.
+         *
+         * Every time the file was saved (and did not change for @ref WatchOptions::_debounce),
+         * it is parsed again and only the properties which changed or were added are pushed
+         * to the participants they belong to (see @ref AppliedProperties).
+         * The reloads run on a thread of the watcher, errors of a reload (e.g. a file saved half way)
+         * are passed to @ref WatchOptions::_reload_callback and the watch goes on.
+         *
+         * @remark The system must neither be destroyed nor configured otherwise while it is watched.
+         */
+        class FEP3_CONTROLLER_EXPORT PropertiesWatcher
+        {
+        public:
+            /**
+             * Starts to watch @p system_properties_file for the @p system
+             *
+             * @param [in] system The configured system
+             * @param [in] system_properties_file The filepath to the system properties file
+             * @param [in] options The options to use
+             *
+             * @throws std::runtime_error if the file can not be watched
+             *                            if the file can not be parsed (if changes are determined against its content)
+             */
+            PropertiesWatcher(fep3::System& system,
+                              const std::string& system_properties_file,
+                              const WatchOptions& options = WatchOptions());
+            /**
+             * Starts to watch @p system_properties_file for the participants accessed through @p system
+             *
+             * @param [in] system The access to the configured system
+             * @param [in] system_properties_file The filepath to the system properties file
+             * @param [in] options The options to use
+             *
+             * @throws std::runtime_error see the overload for a fep3::System
+             */
+            PropertiesWatcher(ISystemAccess& system,
+                              const std::string& system_properties_file,
+                              const WatchOptions& options = WatchOptions());
+            /// DTOR, stops the watch
+            ~PropertiesWatcher();
+            PropertiesWatcher(const PropertiesWatcher&) = delete;
+            PropertiesWatcher& operator=(const PropertiesWatcher&) = delete;
+            PropertiesWatcher(PropertiesWatcher&&) = delete;
+            PropertiesWatcher& operator=(PropertiesWatcher&&) = delete;
+
+            /**
+             * Stops the watch, waits for a running reload to finish.
+             * Must not be called from @ref WatchOptions::_reload_callback.
+             */
+            void stop();
+            /**
+             * @return the number of reloads so far (successful or not)
+             */
+            uint64_t getReloadCount() const;
+
+        private:
+            std::unique_ptr<detail::PropertiesWatcherData> _data;
+        };
+    } // namespace controller
+} // namespace fep3
@@ -0,0 +1,134 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * A single property value to be written to a participant
+         */
+        struct PropertyAssignment
+        {
+            /// name (path) of the property relative to the node it is written to
+            std::string _name;
+            /// type name of the property
+            std::string _type;
+            /// value of the property
+            std::string _value;
+        };
+
+        /**
+         * Describes a property of a batch which could not be set
+         */
+        struct PropertyWriteError
+        {
+            /// index of the property within the batch
+            size_t _index;
+            /// reason why the property was refused (might be empty)
+            std::string _reason;
+        };
+
+        /**
+         * A set of properties serialized once by @ref IPropertyBatchWriter::serialize
+         * to be sent to several participants. The content is up to the writer.
+         */
+        class ISerializedProperties
+        {
+        public:
+            /// DTOR
+            virtual ~ISerializedProperties() = default;
+        };
+
+        /**
+         * Interface to write a whole set of properties of one participant within one request.
+         *
+         * The FEP 3 configuration RPC service only offers to set one property per call.
+         * Participants (or service bus setups) providing a bulk write facility can be
+         * plugged into the controller by a @ref PropertyBatchWriterFactory.
+         */
+        class IPropertyBatchWriter
+        {
+        public:
+            /// DTOR
+            virtual ~IPropertyBatchWriter() = default;
+
+            /**
+             * Sets all @p properties below the node @p node_path within one request.
+             *
+             * @param [in] node_path the path of the property node ("/" or "/system")
+             * @param [in] properties the properties to set
+             *
+             * @return the properties which could not be set, an empty list if all properties were set
+             * @throws std::runtime_error if the participant can not be reached
+             */
+            virtual std::vector<PropertyWriteError> setProperties(const std::string& node_path,
+                                                                  const std::vector<PropertyAssignment>& properties) = 0;
+
+            /**
+             * Serializes @p properties to be set below the node @p node_path of several participants.
+             * Used to broadcast the system properties (see @ref ConfigureOptions::_broadcast_system_properties),
+             * called once per writer type, the result is passed to @ref setSerializedProperties of the writers
+             * of all participants with the same type.
+             * The default does not serialize, the properties are then passed to @ref setProperties per participant.
+             *
+             * @param [in] node_path the path of the property node ("/system")
+             * @param [in] properties the properties to set
+             *
+             * @return the serialized properties, an empty pointer if the writer does not serialize
+             */
+            virtual std::shared_ptr<const ISerializedProperties> serialize(const std::string& /*node_path*/,
+                const std::vector<PropertyAssignment>& /*properties*/)
+            {
+                return {};
+            }
+
+            /**
+             * Sets the properties serialized by @ref serialize of a writer of the same type within one request.
+             *
+             * @param [in] serialized_properties the properties to set
+             *
+             * @return the properties which could not be set (indices as passed to @ref serialize),
+             *         an empty list if all properties were set
+             * @throws std::runtime_error if the participant can not be reached
+             */
+            virtual std::vector<PropertyWriteError> setSerializedProperties(
+                const ISerializedProperties& /*serialized_properties*/)
+            {
+                throw std::runtime_error("the batch writer does not support serialized properties");
+            }
+        };
+
+        /**
+         * Creates the batch writer for a participant.
+         * Returns an empty pointer if the participant does not support batched writes,
+         * the properties of this participant are then set one by one.
+         */
+        using PropertyBatchWriterFactory =
+            std::function<std::shared_ptr<IPropertyBatchWriter>(fep3::ParticipantProxy& participant)>;
+    } // namespace controller
+} // namespace fep3
@@ -0,0 +1,108 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <fep_system/fep_system.h>
+#include <fep_controller/fep_controller_export.h>
+#include <fep_controller/configuration_report.h>
+#include <fep_controller/deadlines.h>
+#include <fep_controller/progress.h>
+#include <fep_controller/snapshot.h>
+#include <fep_controller/system_access_intf.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * Options of @ref exportSystemProperties
+         */
+        struct ExportOptions
+        {
+            /// Number of participants read concurrently
+            size_t _worker_count = 16;
+            /**
+             * If set, a participant (or one of its nodes) which can not be read does not stop the export.
+             * It is recorded within the report (which is cleared first) with the node path and the reason,
+             * and is left out of the written file.
+             */
+            ConfigurationReport* _report = nullptr;
+            /// Time limits of the export, the participants and the single requests
+            DeadlineOptions _deadlines;
+            /// Retries of requests to the participants which failed transiently
+            RetryOptions _retry;
+            /**
+             * Checked before every participant is read, the export stops with
+             * @ref OperationCancelledError once it is cancelled.
+             */
+            CancellationToken _cancellation_token;
+        };
+
+        /**
+         * Reads the properties of all participants of @p system and writes them as system properties file,
+         * e.g. to audit the actual configuration of a running system or to compare it with a later state.
+         * The participants are read concurrently (see @ref ExportOptions::_worker_count),
+         * each one node by node from "/" and "/system" via the configuration RPC service.
+         * Properties of the type "node" are not written, the properties below them are.
+         *
+         * The properties of "/system" of the first participant read become the system properties,
+         * the properties of the other participants whose "/system" differs from them are written as
+         * properties "system/<name>" of their element instance (a property missing within "/system"
+         * of another participant can not be expressed). Everything below "/" except "/system"
+         * becomes the properties of the element instance of the participant.
+         * The system timing is not read, the file has no system timing properties.
+         *
+         * If @p system_properties_file has the extension @ref snapshot_file_extension a snapshot is written
+         * once all participants are read. Otherwise an xml system properties file is written,
+         * participant by participant in the order of the system as soon as the participant
+         * and the ones before it are read.
+         * The file is written to a temporary file of a unique name next to @p system_properties_file
+         * (with the suffix ".<process id>.<counter>.tmp") and replaces @p system_properties_file once it is complete. If the export fails, an existing
+         * @p system_properties_file is left untouched.
+         *
+         * @param [in] system The system to read the properties from
+         * @param [in] system_properties_file The filepath of the system properties file to write
+         * @param [in] options The options to use
+         *
+         * @throws std::runtime_error if @p system_properties_file can not be written
+         *                            if a participant can not be read
+         *                            (recorded instead if @ref ExportOptions::_report is set)
+         * @throws OperationCancelledError if the export was cancelled
+         */
+        void FEP3_CONTROLLER_EXPORT exportSystemProperties(fep3::System& system,
+                                                          const std::string& system_properties_file,
+                                                          const ExportOptions& options = ExportOptions());
+
+        /**
+         * Reads the properties of the participants accessed through @p system and writes them
+         * as system properties file. Behaves like the overload for a fep3::System.
+         *
+         * @param [in] system The access to the system to read the properties from
+         * @param [in] system_properties_file The filepath of the system properties file to write
+         * @param [in] options The options to use
+         *
+         * @throws std::runtime_error see @ref exportSystemProperties
+         */
+        void FEP3_CONTROLLER_EXPORT exportSystemProperties(ISystemAccess& system,
+                                                          const std::string& system_properties_file,
+                                                          const ExportOptions& options);
+    } // namespace controller
+} // namespace fep3
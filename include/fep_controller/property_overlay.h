@@ -0,0 +1,98 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+#include <fep_controller/fep_controller_export.h>
+#include <fep_controller/fep_controller.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * A property of a system properties file replaced by a @ref PropertyOverlay
+         */
+        struct PropertyOverride
+        {
+            /// the element id (participant name) of the property, empty for a system property
+            std::string _element_id;
+            /// name of the property as within the system properties file
+            std::string _name;
+            /// type of the property, empty to keep the type of the replaced property
+            std::string _type;
+            /// the value of the property
+            std::string _value;
+        };
+
+        /**
+         * A variant of the properties of a system properties file (the base),
+         * e.g. one step of a parameter sweep.
+         * A property which is not within the base is added, its type must be given then.
+         * If a property is overridden more than once, the last override wins.
+         * The system timing properties can not be overridden.
+         */
+        struct PropertyOverlay
+        {
+            /// the overrides of the base
+            std::vector<PropertyOverride> _overrides;
+        };
+
+        /**
+         * Sets the properties of @p base_properties_file with @p overlay applied for the @p system.
+         * The base file is parsed once (see @ref setDescriptionCacheLimit), every call only merges the overlay.
+         * If @ref ConfigureOptions::_applied_properties is set, only the properties changed since the previous
+         * call with the same object are pushed: the overrides of @p overlay and the properties of the previous
+         * overlay which fall back to their base value. Stepping through a sweep therefore only contacts the
+         * participants whose properties differ between the variants.
+         * A property added by a previous overlay has no base value to fall back to, it keeps its value
+         * at the participant and is not reverted by a later overlay.
+         *
+         * @param [in] system The system for which the properties should be set
+         * @param [in] base_properties_file The filepath to the base system properties file
+         * @param [in] overlay The overrides of the base properties
+         * @param [in] options The options to use
+         *
+         * @throws std::runtime_error if an added property has no type
+         *                            see @ref configureSystemProperties for the other failures
+         */
+        void FEP3_CONTROLLER_EXPORT applyPropertyOverlay(fep3::System& system,
+                                                        const std::string& base_properties_file,
+                                                        const PropertyOverlay& overlay,
+                                                        const ConfigureOptions& options);
+
+        /**
+         * Sets the properties of @p base_properties_file with @p overlay applied for the participants
+         * accessed through @p system. Behaves like the overload for a fep3::System.
+         *
+         * @param [in] system The access to the system for which the properties should be set
+         * @param [in] base_properties_file The filepath to the base system properties file
+         * @param [in] overlay The overrides of the base properties
+         * @param [in] options The options to use
+         *
+         * @throws std::runtime_error see @ref applyPropertyOverlay
+         */
+        void FEP3_CONTROLLER_EXPORT applyPropertyOverlay(ISystemAccess& system,
+                                                        const std::string& base_properties_file,
+                                                        const PropertyOverlay& overlay,
+                                                        const ConfigureOptions& options);
+    } // namespace controller
+} // namespace fep3
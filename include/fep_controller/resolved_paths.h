@@ -0,0 +1,88 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <fep_controller/fep_controller_export.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        namespace detail
+        {
+            struct ResolvedPathsData;
+        }
+
+        /**
+         * Remembers the file references (timing files, mappings) resolved relative to the directory
+         * of the description file which referenced them.
+         * Every distinct pair of reference and directory is normalized only once.
+         *
+         * @ref connectSystem uses a new instance per call, pass one via @ref ConnectOptions::_resolved_paths
+         * to keep the resolved paths for later steps or to share them between several connects.
+         *
+         * @remark An instance must not be used by concurrent calls.
+         */
+        class FEP3_CONTROLLER_EXPORT ResolvedPaths
+        {
+        public:
+            /// CTOR
+            ResolvedPaths();
+            /// DTOR
+            ~ResolvedPaths();
+            /// move CTOR
+            ResolvedPaths(ResolvedPaths&& other);
+            /// move assignment
+            ResolvedPaths& operator=(ResolvedPaths&& other);
+            ResolvedPaths(const ResolvedPaths&) = delete;
+            ResolvedPaths& operator=(const ResolvedPaths&) = delete;
+
+            /**
+             * Resolves @p file_reference relative to @p base_directory (if it is relative) and makes it canonical.
+             * References starting with a macro "$(" are only trimmed.
+             *
+             * @param [in] file_reference the reference as found in the description file
+             * @param [in] base_directory the directory of the description file
+             * @return the resolved path, computed on the first call for this pair only
+             */
+            const std::string& resolve(const std::string& file_reference, const std::string& base_directory);
+            /**
+             * Looks up an already resolved reference.
+             *
+             * @param [in] file_reference the reference as found in the description file
+             * @param [in] base_directory the directory of the description file
+             * @return the resolved path, nullptr if the pair was not resolved yet
+             */
+            const std::string* find(const std::string& file_reference, const std::string& base_directory) const;
+            /**
+             * @return the number of resolved pairs of reference and directory
+             */
+            size_t size() const;
+            /**
+             * Forgets all resolved paths
+             */
+            void clear();
+
+        private:
+            std::unique_ptr<detail::ResolvedPathsData> _data;
+        };
+    } // namespace controller
+} // namespace fep3
@@ -0,0 +1,64 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <string>
+
+#include <fep_controller/fep_controller_export.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * The extension of snapshot files (without the dot).
+         *
+         * A snapshot is a compact binary copy of a parsed system sdk description or system properties file.
+         * It carries a version and a checksum and is memory mapped and read in place when loaded,
+         * there is no xml to parse. @ref connectSystem and @ref configureSystemProperties load every file
+         * with this extension as snapshot. Relative file references of the participants are resolved
+         * relative to the directory of the snapshot, like those of the description it was made from.
+         * A snapshot can only be loaded on a platform with the byte order it was written on.
+         */
+        constexpr char snapshot_file_extension[] = "fep_snapshot";
+
+        /**
+         * Converts a system sdk description file into a snapshot
+         *
+         * @param [in] system_sdk_description_file The filepath to the system sdk description file
+         * @param [in] snapshot_file The filepath of the snapshot to write
+         *
+         * @throws std::runtime_error if @p system_sdk_description_file can not be found, read or parsed
+         *                            if @p snapshot_file can not be written
+         */
+        void FEP3_CONTROLLER_EXPORT convertSystemDescriptionToSnapshot(const std::string& system_sdk_description_file,
+                                                                       const std::string& snapshot_file);
+
+        /**
+         * Converts a system properties file into a snapshot
+         *
+         * @param [in] system_properties_file The filepath to the system properties file
+         * @param [in] snapshot_file The filepath of the snapshot to write
+         *
+         * @throws std::runtime_error if @p system_properties_file can not be found, read or parsed
+         *                            if @p snapshot_file can not be written
+         */
+        void FEP3_CONTROLLER_EXPORT convertSystemPropertiesToSnapshot(const std::string& system_properties_file,
+                                                                      const std::string& snapshot_file);
+    } // namespace controller
+} // namespace fep3
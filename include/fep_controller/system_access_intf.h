@@ -0,0 +1,131 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+#include <fep_controller/property_batch_writer_intf.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * Access to one participant of a system, as far as the controller needs it.
+         */
+        class IParticipantAccess
+        {
+        public:
+            /// DTOR
+            virtual ~IParticipantAccess() = default;
+
+            /**
+             * @return the name of the participant
+             */
+            virtual std::string getName() const = 0;
+            /**
+             * @return the init priority of the participant
+             */
+            virtual int32_t getInitPriority() const = 0;
+            /**
+             * @return the configuration RPC service of the participant
+             * @throws std::runtime_error if the participant can not be reached
+             */
+            virtual std::shared_ptr<fep3::rpc::IRPCConfiguration> getConfiguration() = 0;
+            /**
+             * Drops @p configuration after a request on it failed,
+             * so the next @ref getConfiguration connects anew instead of returning it again.
+             * @param [in] configuration the service returned by @ref getConfiguration before
+             */
+            virtual void dropConfiguration(const std::shared_ptr<fep3::rpc::IRPCConfiguration>& configuration) = 0;
+            /**
+             * @return the writer to set all properties of a node within one request,
+             *         nullptr if the properties have to be set one by one via @ref getConfiguration
+             */
+            virtual std::shared_ptr<IPropertyBatchWriter> getBatchWriter() = 0;
+            /**
+             * @return true if @ref getBatchWriter is expected to provide a writer, without creating one
+             *         (used to plan the requests, a participant whose @ref getBatchWriter returns nullptr
+             *         after all is replanned)
+             */
+            virtual bool hasBatchWriter() const = 0;
+            /**
+             * Brings the participant from the unloaded to the loaded state,
+             * does nothing if the participant is loaded already.
+             * @throws std::runtime_error if the participant can not be reached or is not loaded afterwards
+             */
+            virtual void load() = 0;
+        };
+
+        /**
+         * Access to a system, as far as the controller needs it.
+         *
+         * @ref configureSystemProperties uses this interface for all communication with the participants.
+         * A fep3::System is accessed via the service bus, other implementations
+         * (e.g. an in-process stand-in for tests and benchmarks) can be passed to the
+         * @ref configureSystemProperties overload taking an ISystemAccess.
+         */
+        class ISystemAccess
+        {
+        public:
+            /// DTOR
+            virtual ~ISystemAccess() = default;
+
+            /**
+             * @return the name of the system
+             */
+            virtual std::string getSystemName() const = 0;
+            /**
+             * @return the participants of the system in the order they were added
+             */
+            virtual std::vector<std::shared_ptr<IParticipantAccess>> getParticipants() = 0;
+            /**
+             * Brings all participants to @p state
+             *
+             * @param [in] state the state to reach
+             * @param [in] timeout the time to reach the state, 0 uses the default timeout of the system
+             * @throws std::runtime_error if the state can not be reached
+             */
+            virtual void setSystemState(fep3::SystemAggregatedState state, std::chrono::milliseconds timeout) = 0;
+            /**
+             * @return the aggregated state of the participants
+             */
+            virtual fep3::SystemState getSystemState() = 0;
+
+            /// see fep3::System::configureTiming3NoMaster
+            virtual void configureTiming3NoMaster() = 0;
+            /// see fep3::System::configureTiming3ClockSyncOnlyInterpolation
+            virtual void configureTiming3ClockSyncOnlyInterpolation(const std::string& master_element_id,
+                                                                    const std::string& slave_sync_cycle_time) = 0;
+            /// see fep3::System::configureTiming3ClockSyncOnlyDiscrete
+            virtual void configureTiming3ClockSyncOnlyDiscrete(const std::string& master_element_id,
+                                                               const std::string& slave_sync_cycle_time) = 0;
+            /// see fep3::System::configureTiming3DiscreteSteps
+            virtual void configureTiming3DiscreteSteps(const std::string& master_element_id,
+                                                       const std::string& master_time_stepsize,
+                                                       const std::string& master_time_factor) = 0;
+            /// see fep3::System::configureTiming3AFAP
+            virtual void configureTiming3AFAP(const std::string& master_element_id,
+                                              const std::string& master_time_stepsize) = 0;
+        };
+    } // namespace controller
+} // namespace fep3
@@ -0,0 +1,124 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+#include <fep_controller/fep_controller_export.h>
+#include <fep_controller/configuration_report.h>
+#include <fep_controller/fep_controller.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        /**
+         * A system to bring up by @ref bringUpSystems
+         */
+        struct SystemJob
+        {
+            /// the filepath to the system sdk description file
+            std::string _system_sdk_description_file;
+            /// the filepath to the system properties file
+            std::string _system_properties_file;
+        };
+
+        /**
+         * The outcome of a @ref SystemJob
+         */
+        struct SystemJobResult
+        {
+            /// the index of the job within the jobs passed to @ref bringUpSystems
+            size_t _job_index = 0;
+            /// the connected and configured system, empty if the job failed
+            std::unique_ptr<fep3::System> _system;
+            /// the error of a failed job, empty if the job succeeded
+            std::string _error_message;
+            /// the failures of the participants, filled if @ref BatchOptions::_collect_failures is set
+            ConfigurationReport _report;
+        };
+
+        /**
+         * Called once a job completed, successfully or not.
+         * The callback may take over @ref SystemJobResult::_system, it is then empty within the returned results.
+         *
+         * @param [in] result the result of the job
+         */
+        using SystemJobCallback = std::function<void(SystemJobResult& result)>;
+
+        /**
+         * Options of @ref bringUpSystems
+         */
+        struct BatchOptions
+        {
+            /**
+             * Number of threads running the participant work (loading and setting the properties) of all systems.
+             * This bounds the requests to participants running at the same time.
+             */
+            size_t _worker_count = 16;
+            /**
+             * Number of jobs running at the same time, each on a thread of its own.
+             * A job connects its system and waits for its participant work on the shared workers,
+             * so this bounds the job threads and the systems connecting at the same time
+             * (0 and 1 run the jobs one after another).
+             */
+            size_t _job_count = 8;
+            /**
+             * The options of the configuration of every system.
+             * @ref ConfigureOptions::_worker_count limits the workers of one system within the shared ones.
+             * @ref ConfigureOptions::_load_participants is always set (see @ref bringUpSystem).
+             * @ref ConfigureOptions::_progress_callback, @ref ConfigureOptions::_applied_properties,
+             * @ref ConfigureOptions::_plan, @ref ConfigureOptions::_report and @ref ConfigureOptions::_retry_report
+             * are not used, they would be shared by all systems.
+             * The cancellation token cancels the connects as well.
+             */
+            ConfigureOptions _configure_options;
+            /**
+             * If true, failures of single participants do not fail the job,
+             * they are recorded within @ref SystemJobResult::_report (see @ref ConfigureOptions::_report).
+             */
+            bool _collect_failures = false;
+            /**
+             * If set, called for every job as soon as it completed. The calls are serialized
+             * but come from the threads of the jobs. The callback must not throw.
+             */
+            SystemJobCallback _result_callback;
+        };
+
+        /**
+         * Brings up several systems concurrently, what @ref bringUpSystem does for each of the @p jobs.
+         * Every distinct system sdk description and system properties file is parsed once,
+         * jobs with the same files share the parsed content.
+         * At most @ref BatchOptions::_job_count jobs run at the same time,
+         * the participant work of all systems runs on @ref BatchOptions::_worker_count shared threads.
+         * A failing job does not stop the others.
+         *
+         * @param [in] jobs the systems to bring up
+         * @param [in] options the options to use
+         *
+         * @return the results in the order of @p jobs
+         */
+        std::vector<SystemJobResult> FEP3_CONTROLLER_EXPORT bringUpSystems(const std::vector<SystemJob>& jobs,
+                                                                          const BatchOptions& options = BatchOptions());
+    } // namespace controller
+} // namespace fep3
@@ -0,0 +1,128 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include <fep_controller/fep_controller_export.h>
+
+namespace fep3
+{
+    namespace controller
+    {
+        namespace detail
+        {
+            struct ChromeTraceData;
+        }
+
+        /**
+         * A finished phase of a controller operation
+         */
+        struct TraceSpan
+        {
+            /// name of the phase (e.g. "dom.load", "setProperty")
+            const char* _name = "";
+            /// the participant the phase belongs to, empty for phases of the whole system or file
+            std::string _participant_name;
+            /// additional information (e.g. the file or the property name), might be empty
+            std::string _detail;
+            /// begin of the phase
+            std::chrono::steady_clock::time_point _begin;
+            /// end of the phase
+            std::chrono::steady_clock::time_point _end;
+            /// the thread the phase ran on
+            std::thread::id _thread_id;
+        };
+
+        /**
+         * Receives the phases of the controller operations.
+         * @ref onSpan is called from every thread the controller uses, so implementations must be thread safe.
+         */
+        class ITraceSink
+        {
+        public:
+            /// DTOR
+            virtual ~ITraceSink() = default;
+            /**
+             * Called whenever a phase finished
+             *
+             * @param [in] span the finished phase
+             */
+            virtual void onSpan(const TraceSpan& span) = 0;
+        };
+
+        /**
+         * Sets the sink receiving the phases of all controller operations.
+         * Without a sink (default) the phases are not measured at all.
+         *
+         * @param [in] sink the sink to use, nullptr removes the current sink
+         */
+        void FEP3_CONTROLLER_EXPORT setTraceSink(std::shared_ptr<ITraceSink> sink);
+
+        /**
+         * @return the current sink (nullptr if none is set)
+         */
+        std::shared_ptr<ITraceSink> FEP3_CONTROLLER_EXPORT getTraceSink();
+
+        /**
+         * Collects the phases and writes them in the Chrome trace event format
+         * (loadable by chrome://tracing or https://ui.perfetto.dev).
+         */
+        class FEP3_CONTROLLER_EXPORT ChromeTraceWriter : public ITraceSink
+        {
+        public:
+            /// CTOR, timestamps are written relative to the construction
+            ChromeTraceWriter();
+            /// DTOR
+            ~ChromeTraceWriter();
+            ChromeTraceWriter(const ChromeTraceWriter&) = delete;
+            ChromeTraceWriter& operator=(const ChromeTraceWriter&) = delete;
+
+            void onSpan(const TraceSpan& span) override;
+
+            /**
+             * Writes the collected phases as json to @p stream
+             *
+             * @param [in] stream the stream to write to
+             */
+            void write(std::ostream& stream) const;
+            /**
+             * Writes the collected phases as json to the file @p file_path
+             *
+             * @param [in] file_path the file to write
+             * @throws std::runtime_error if the file can not be written
+             */
+            void writeToFile(const std::string& file_path) const;
+            /**
+             * @return the number of collected phases
+             */
+            size_t getSpanCount() const;
+            /**
+             * Drops the collected phases
+             */
+            void clear();
+
+        private:
+            std::unique_ptr<detail::ChromeTraceData> _data;
+        };
+    } // namespace controller
+} // namespace fep3
@@ -0,0 +1,142 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "applied_properties_data.h"
+
+#include <algorithm>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    PropertyList getChangedProperties(const PropertyList& wanted, const AppliedNode& applied)
+    {
+        PropertyListBuilder changed;
+        for (size_t index = 0; index < wanted.size(); ++index)
+        {
+            const auto& name = wanted.getName(index);
+            auto found = applied.find(name);
+            if (found == applied.end()
+                || !wanted.hasValue(index, found->second._value)
+                || found->second._type != wanted.getType(index))
+            {
+                changed.add(name, wanted.getType(index), wanted.getValue(index));
+            }
+        }
+        return changed.finishList();
+    }
+
+    void recordAppliedProperties(AppliedNode& applied,
+                                 const PropertyList& properties,
+                                 const std::vector<size_t>& refused)
+    {
+        for (size_t index = 0; index < properties.size(); ++index)
+        {
+            if (std::find(refused.begin(), refused.end(), index) == refused.end())
+            {
+                applied[properties.getName(index)] = { properties.getType(index), properties.getValue(index) };
+            }
+        }
+    }
+
+    bool isEqual(const PropertyList& left, const PropertyList& right)
+    {
+        if (left.size() != right.size())
+        {
+            return false;
+        }
+        for (size_t index = 0; index < left.size(); ++index)
+        {
+            if (left.getName(index) != right.getName(index)
+                || left.getType(index) != right.getType(index)
+                || !left.hasValue(index, right.getValue(index)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void recordAppliedTable(AppliedPropertiesData& applied,
+                            const std::string& system_name,
+                            const std::vector<std::string>& participant_names,
+                            const PropertyTable& property_table)
+    {
+        applied = AppliedPropertiesData();
+        applied._system_name = system_name;
+        for (const auto& participant_name : participant_names)
+        {
+            auto& applied_participant = applied._participants[participant_name];
+            recordAppliedProperties(applied_participant._system_properties, property_table.getSystemProperties());
+            const auto element_properties = property_table.findElementProperties(participant_name);
+            if (element_properties)
+            {
+                recordAppliedProperties(applied_participant._element_properties, *element_properties);
+            }
+        }
+        applied._timing_properties = property_table.getSystemTimingProperties();
+        applied._timing_applied = true;
+    }
+} // namespace detail
+
+AppliedProperties::AppliedProperties()
+    : _data(new detail::AppliedPropertiesData())
+{
+}
+
+AppliedProperties::~AppliedProperties() = default;
+
+AppliedProperties::AppliedProperties(AppliedProperties&& other)
+    : _data(new detail::AppliedPropertiesData())
+{
+    std::swap(_data, other._data);
+}
+
+AppliedProperties& AppliedProperties::operator=(AppliedProperties&& other)
+{
+    std::swap(_data, other._data);
+    return *this;
+}
+
+void AppliedProperties::clear()
+{
+    *_data = detail::AppliedPropertiesData();
+}
+
+void AppliedProperties::clear(const std::string& participant_name)
+{
+    _data->_participants.erase(participant_name);
+}
+
+bool AppliedProperties::empty() const
+{
+    return _data->_participants.empty() && !_data->_timing_applied;
+}
+
+size_t AppliedProperties::getPropertyCount(const std::string& participant_name) const
+{
+    auto found = _data->_participants.find(participant_name);
+    if (found != _data->_participants.end())
+    {
+        return found->second._system_properties.size() + found->second._element_properties.size();
+    }
+    return 0;
+}
+} // namespace controller
+} // namespace fep3
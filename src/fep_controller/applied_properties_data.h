@@ -0,0 +1,97 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/applied_properties.h>
+
+#include "property_table.h"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /// type and value of an applied property
+    struct AppliedValue
+    {
+        std::string _type;
+        std::string _value;
+    };
+
+    /// applied properties of one property node, keyed by property name
+    using AppliedNode = std::unordered_map<std::string, AppliedValue>;
+
+    /// applied properties of one participant
+    struct AppliedParticipant
+    {
+        AppliedNode _system_properties;
+        AppliedNode _element_properties;
+    };
+
+    struct AppliedPropertiesData
+    {
+        std::string _system_name;
+        bool _timing_applied = false;
+        PropertyList _timing_properties;
+        std::unordered_map<std::string, AppliedParticipant> _participants;
+    };
+
+    struct AppliedPropertiesAccess
+    {
+        static AppliedPropertiesData& get(AppliedProperties& applied_properties)
+        {
+            return *applied_properties._data;
+        }
+    };
+
+    /**
+     * @return the properties of @p wanted which are not within @p applied or have a different type or value
+     */
+    PropertyList getChangedProperties(const PropertyList& wanted, const AppliedNode& applied);
+
+    /**
+     * Records @p properties as applied within @p applied,
+     * except the ones at the indices @p refused (which the participant refused to set)
+     */
+    void recordAppliedProperties(AppliedNode& applied,
+                                 const PropertyList& properties,
+                                 const std::vector<size_t>& refused = std::vector<size_t>());
+
+    /**
+     * @return true if @p left and @p right contain the same properties in the same order
+     */
+    bool isEqual(const PropertyList& left, const PropertyList& right);
+
+    /**
+     * Records everything of @p property_table as applied to the participants @p participant_names
+     * of the system @p system_name, replacing what was recorded before.
+     * Used for a system which is known to be configured with @p property_table.
+     */
+    void recordAppliedTable(AppliedPropertiesData& applied,
+                            const std::string& system_name,
+                            const std::vector<std::string>& participant_names,
+                            const PropertyTable& property_table);
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,140 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/system_access_intf.h>
+#include <a_util/strings.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * A property node of a participant, fetched via its configuration RPC service on first use.
+     * If a request on the node fails, the node and the configuration service of the participant
+     * are dropped, so the next attempt connects anew instead of reusing a broken proxy.
+     * The mutex is not held during a request.
+     */
+    class ConfigurationNode
+    {
+    public:
+        ConfigurationNode(std::shared_ptr<IParticipantAccess> participant, std::string node_path)
+            : _participant(std::move(participant)),
+              _node_path(std::move(node_path))
+        {
+        }
+
+        /**
+         * Fetches the node if it is not fetched yet
+         * @throws std::runtime_error if the node can not be accessed
+         */
+        void fetch()
+        {
+            getNode();
+        }
+
+        /**
+         * Calls @p request with the node, fetching it first if needed
+         *
+         * @return the result of @p request
+         * @throws std::runtime_error if the node can not be accessed or the error of @p request,
+         *         the node is dropped then
+         */
+        template <typename Request>
+        auto call(Request request) -> decltype(request(std::declval<fep3::IProperties&>()))
+        {
+            const auto node = getNode();
+            try
+            {
+                return request(*node.second);
+            }
+            catch (...)
+            {
+                drop(node);
+                throw;
+            }
+        }
+
+    private:
+        using Node = std::pair<std::shared_ptr<fep3::rpc::IRPCConfiguration>, std::shared_ptr<fep3::IProperties>>;
+
+        Node getNode()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_node.second)
+                {
+                    return _node;
+                }
+            }
+            Node node;
+            try
+            {
+                node.first = _participant->getConfiguration();
+                if (!node.first)
+                {
+                    throw std::runtime_error("the configuration service can not be reached");
+                }
+                node.second = node.first->getProperties(_node_path);
+            }
+            catch (...)
+            {
+                drop(node);
+                throw;
+            }
+            if (!node.second)
+            {
+                drop(node);
+                throw std::runtime_error(a_util::strings::format("the node %s can not be accessed", _node_path.c_str()));
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            _node = node;
+            return node;
+        }
+
+        void drop(const Node& node)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_node.second == node.second)
+                {
+                    _node = Node();
+                }
+            }
+            if (node.first)
+            {
+                _participant->dropConfiguration(node.first);
+            }
+        }
+
+    private:
+        const std::shared_ptr<IParticipantAccess> _participant;
+        const std::string _node_path;
+        std::mutex _mutex;
+        Node _node;
+    };
+} // namespace detail
+} // namespace controller
+} // namespace fep3
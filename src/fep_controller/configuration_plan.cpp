@@ -0,0 +1,119 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "configuration_planner.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    PlannedParticipant planParticipant(const std::string& participant_name,
+                                       const PropertyList& system_properties,
+                                       const PropertyList* element_properties,
+                                       bool batched,
+                                       bool broadcast)
+    {
+        PlannedParticipant planned;
+        planned._participant_name = participant_name;
+        planned._system_property_count = system_properties.size();
+        planned._element_property_count = element_properties ? element_properties->size() : 0;
+        planned._batched = batched;
+        planned._broadcast = broadcast && planned._system_property_count > 0;
+        for (const auto property_count : { planned._system_property_count, planned._element_property_count })
+        {
+            if (property_count > 0)
+            {
+                //one batch per node, or the node access followed by one request per property
+                planned._round_trips += batched ? 1 : 1 + property_count;
+            }
+        }
+        return planned;
+    }
+
+    std::vector<std::vector<size_t>> makePriorityWaves(const std::vector<int32_t>& init_priorities)
+    {
+        std::map<int32_t, std::vector<size_t>, std::greater<int32_t>> waves_by_priority;
+        for (size_t index = 0; index < init_priorities.size(); ++index)
+        {
+            waves_by_priority[init_priorities[index]].push_back(index);
+        }
+        std::vector<std::vector<size_t>> waves;
+        waves.reserve(waves_by_priority.size());
+        for (auto& wave : waves_by_priority)
+        {
+            waves.push_back(std::move(wave.second));
+        }
+        return waves;
+    }
+} // namespace detail
+
+size_t getRoundTripCount(const ConfigurationPlan& plan)
+{
+    size_t round_trips = 0;
+    for (const auto& planned : plan._participants)
+    {
+        round_trips += planned._round_trips;
+    }
+    return round_trips;
+}
+
+void writeConfigurationPlan(const ConfigurationPlan& plan, std::ostream& stream)
+{
+    stream << "system " << plan._system_name << ": "
+           << getRoundTripCount(plan) << " round trips to "
+           << plan._participants.size() << " participants";
+    if (plan._wave_count > 1)
+    {
+        stream << " in " << plan._wave_count << " waves";
+    }
+    stream << "\n";
+    if (plan._load_system)
+    {
+        stream << "  setSystemState(loaded)\n";
+    }
+    for (const auto& planned : plan._participants)
+    {
+        stream << "  " << planned._participant_name;
+        if (plan._wave_count > 1)
+        {
+            stream << " (wave " << planned._wave << ")";
+        }
+        stream << ": ";
+        if (planned._round_trips == 0)
+        {
+            stream << "nothing to set\n";
+            continue;
+        }
+        stream << planned._system_property_count << " system properties"
+               << (planned._broadcast ? " (broadcast)" : "") << ", "
+               << planned._element_property_count << " element properties"
+               << (planned._batched ? " (batched)" : "") << ", "
+               << planned._round_trips << " round trips\n";
+    }
+    if (plan._configure_timing)
+    {
+        stream << "  configureSystemTiming(" << plan._timing_configuration_type << ")\n";
+    }
+}
+} // namespace controller
+} // namespace fep3
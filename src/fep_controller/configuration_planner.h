@@ -0,0 +1,61 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/configuration_plan.h>
+
+#include "property_table.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * Plans the requests needed to set @p system_properties and @p element_properties on a participant.
+     * A node is only accessed if there is something to set within it.
+     *
+     * @param [in] participant_name the name of the participant
+     * @param [in] system_properties the system properties to set
+     * @param [in] element_properties the element instance properties to set, might be nullptr
+     * @param [in] batched true if the participant provides a batch writer
+     * @param [in] broadcast true if @p system_properties are broadcast (taking the same requests)
+     * @return the planned requests
+     */
+    PlannedParticipant planParticipant(const std::string& participant_name,
+                                       const PropertyList& system_properties,
+                                       const PropertyList* element_properties,
+                                       bool batched,
+                                       bool broadcast);
+
+    /**
+     * Groups the participants into waves of equal init priority, the highest priority first.
+     * Within a wave the participants keep their order.
+     *
+     * @param [in] init_priorities the init priority of every participant
+     * @return the indices of the participants grouped by wave
+     */
+    std::vector<std::vector<size_t>> makePriorityWaves(const std::vector<int32_t>& init_priorities);
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,64 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "fep_controller/configuration_report.h"
+
+#include <set>
+
+namespace fep3
+{
+namespace controller
+{
+std::vector<std::string> getParticipantsMissingSystemProperties(const ConfigurationReport& report)
+{
+    std::vector<std::string> participant_names;
+    std::set<std::string> found_names;
+    for (const auto& failure : report._failures)
+    {
+        if (failure._step == ConfigurationStep::property
+            && failure._node_path == "/system"
+            && found_names.insert(failure._participant_name).second)
+        {
+            participant_names.push_back(failure._participant_name);
+        }
+    }
+    return participant_names;
+}
+
+void writeConfigurationReport(const ConfigurationReport& report, std::ostream& stream)
+{
+    stream << "system " << report._system_name << ": " << report._failures.size() << " failures\n";
+    for (const auto& failure : report._failures)
+    {
+        switch (failure._step)
+        {
+        case ConfigurationStep::system_state:
+            stream << "  setSystemState(loaded)";
+            break;
+        case ConfigurationStep::timing:
+            stream << "  configureSystemTiming";
+            break;
+        default:
+            stream << "  " << failure._participant_name << " " << failure._node_path
+                   << " " << failure._property_name << " (" << failure._type << ") = '" << failure._value << "'";
+            break;
+        }
+        stream << ": " << failure._reason << "\n";
+    }
+}
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,188 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "fep_controller/controller.h"
+#include <a_util/strings.h>
+
+#include "controller_steps.h"
+#include "description_loader.h"
+#include "fep_system_access.h"
+#include "trace_scope.h"
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    struct ControllerData
+    {
+        std::shared_ptr<const SystemDescription> _system_description;
+        ResolvedPaths _resolved_paths;
+        std::unique_ptr<fep3::System> _system;
+        //caches the participant accesses and their configuration proxies
+        std::unique_ptr<FepSystemAccess> _system_access;
+        std::shared_ptr<const PropertyTable> _property_table;
+        AppliedProperties _applied_properties;
+    };
+
+    namespace
+    {
+        FepSystemAccess& getConnectedSystem(ControllerData& data)
+        {
+            if (!data._system_access)
+            {
+                throw std::runtime_error("the controller is not connected to a system");
+            }
+            return *data._system_access;
+        }
+
+        void configureConnectedSystem(ControllerData& data,
+                                      const std::string& system_properties_file,
+                                      const ConfigureOptions& options)
+        {
+            auto& system_access = getConnectedSystem(data);
+            TraceScope trace("configureSystemProperties", std::string(), system_properties_file);
+            const OperationDeadline operation_deadline(options._deadlines._operation_deadline);
+            //keep the table, an unchanged file is not parsed again by the next reconfigure
+            data._property_table = loadPropertyTable(system_properties_file, options._streaming_parse_threshold);
+            ProgressReporter progress(options._progress_callback, options._cancellation_token);
+            progress.report(ProgressStage::parsed, std::string());
+            system_access.setBatchWriterFactory(options._batch_writer_factory);
+            configureSystemProperties(system_access, *data._property_table, options, progress, operation_deadline);
+        }
+    }
+} // namespace detail
+
+Controller::Controller()
+    : _data(new detail::ControllerData())
+{
+}
+
+Controller::~Controller() = default;
+
+Controller::Controller(Controller&& other)
+    : _data(new detail::ControllerData())
+{
+    std::swap(_data, other._data);
+}
+
+Controller& Controller::operator=(Controller&& other)
+{
+    std::swap(_data, other._data);
+    return *this;
+}
+
+void Controller::connect(const std::string& system_sdk_description_file, const ConnectOptions& options)
+{
+    if (_data->_system)
+    {
+        throw std::runtime_error(a_util::strings::format("the controller is already connected to the system %s",
+            _data->_system->getSystemName().c_str()));
+    }
+    detail::TraceScope trace("connectSystem", std::string(), system_sdk_description_file);
+    detail::ProgressReporter progress(options._progress_callback, options._cancellation_token);
+    auto system_description = detail::loadSystemDescription(system_sdk_description_file);
+    progress.report(ProgressStage::parsed, std::string());
+
+    _data->_resolved_paths.clear();
+    std::unique_ptr<fep3::System> system(new fep3::System(
+        detail::createSystem(*system_description, system_sdk_description_file, _data->_resolved_paths, progress)));
+    _data->_system_access.reset(new detail::FepSystemAccess(*system, PropertyBatchWriterFactory()));
+    _data->_system = std::move(system);
+    _data->_system_description = std::move(system_description);
+    _data->_applied_properties.clear();
+}
+
+void Controller::configure(const std::string& system_properties_file, const ConfigureOptions& options)
+{
+    ConfigureOptions session_options = options;
+    session_options._applied_properties = nullptr;
+    if (!options._dry_run && !options._retry_report)
+    {
+        //everything is pushed again, what is applied is recorded from scratch
+        detail::getConnectedSystem(*_data);
+        _data->_applied_properties.clear();
+        session_options._applied_properties = &_data->_applied_properties;
+    }
+    detail::configureConnectedSystem(*_data, system_properties_file, session_options);
+}
+
+void Controller::reconfigure(const std::string& system_properties_file, const ConfigureOptions& options)
+{
+    ConfigureOptions session_options = options;
+    session_options._applied_properties = &_data->_applied_properties;
+    detail::configureConnectedSystem(*_data, system_properties_file, session_options);
+}
+
+void Controller::applyOverlay(const PropertyOverlay& overlay, const ConfigureOptions& options)
+{
+    auto& system_access = detail::getConnectedSystem(*_data);
+    if (!_data->_property_table)
+    {
+        throw std::runtime_error("the controller has no base properties, the system was not configured yet");
+    }
+    detail::TraceScope trace("applyOverlay");
+    ConfigureOptions session_options = options;
+    session_options._applied_properties = &_data->_applied_properties;
+    const detail::OperationDeadline operation_deadline(session_options._deadlines._operation_deadline);
+    const auto property_table = detail::mergeOverlay(*_data->_property_table, overlay);
+    detail::ProgressReporter progress(session_options._progress_callback, session_options._cancellation_token);
+    system_access.setBatchWriterFactory(session_options._batch_writer_factory);
+    detail::configureSystemProperties(system_access, property_table, session_options, progress, operation_deadline);
+}
+
+void Controller::teardown()
+{
+    if (!_data->_system)
+    {
+        return;
+    }
+    //release the session first, it is gone even if the participants can not be unloaded
+    auto system = std::move(_data->_system);
+    auto system_access = std::move(_data->_system_access);
+    *_data = detail::ControllerData();
+
+    detail::TraceScope trace("setSystemState(unloaded)");
+    system_access->setSystemState(fep3::SystemAggregatedState::unloaded, std::chrono::milliseconds(0));
+}
+
+bool Controller::isConnected() const
+{
+    return static_cast<bool>(_data->_system);
+}
+
+fep3::System& Controller::getSystem()
+{
+    if (!_data->_system)
+    {
+        throw std::runtime_error("the controller is not connected to a system");
+    }
+    return *_data->_system;
+}
+
+const ResolvedPaths& Controller::getResolvedPaths() const
+{
+    return _data->_resolved_paths;
+}
+
+const AppliedProperties& Controller::getAppliedProperties() const
+{
+    return _data->_applied_properties;
+}
+} // namespace controller
+} // namespace fep3
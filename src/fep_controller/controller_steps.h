@@ -0,0 +1,69 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/fep_controller.h>
+
+#include "progress_reporter.h"
+#include "property_table.h"
+#include "request_runner.h"
+#include "system_description.h"
+#include "worker_pool.h"
+
+#include <string>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * Creates the system described by the already parsed @p system_description
+     * and adds its participants.
+     *
+     * @param [in] system_description the parsed system sdk description
+     * @param [in] system_sdk_description_file the file @p system_description was parsed from,
+     *                                         relative file references are resolved relative to its directory
+     * @param [in] resolved_paths receives the resolved file references
+     * @param [in] progress reports the connected participants and checks the cancellation
+     *
+     * @return the connected system
+     * @throws OperationCancelledError if the connect was cancelled
+     */
+    fep3::System createSystem(const SystemDescription& system_description,
+                              const std::string& system_sdk_description_file,
+                              ResolvedPaths& resolved_paths,
+                              ProgressReporter& progress);
+
+    /**
+     * Sets the already parsed properties @p property_table for the participants accessed through @p system.
+     * Does everything @ref fep3::controller::configureSystemProperties does after parsing the file.
+     * If @p worker_pool is given, the participant work runs on its threads.
+     *
+     * @throws std::runtime_error see @ref fep3::controller::configureSystemProperties
+     */
+    void configureSystemProperties(ISystemAccess& system,
+                                   const PropertyTable& property_table,
+                                   const ConfigureOptions& options,
+                                   ProgressReporter& progress,
+                                   const OperationDeadline& operation_deadline,
+                                   WorkerPool* worker_pool = nullptr);
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,173 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "description_loader.h"
+#include "parse_cache.h"
+#include "snapshot_format.h"
+#include "trace_scope.h"
+
+#include <fep_metamodel/fep_system.h>
+#include <a_util/xml.h>
+#include <a_util/filesystem.h>
+
+#include <stdexcept>
+
+using namespace fep::metamodel;
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    SystemDescription readSystemDescription(const std::string& system_sdk_description_file)
+    {
+        FepSystem system_sdk_file;
+        a_util::xml::DOM dom;
+        bool loaded = false;
+        {
+            TraceScope trace("dom.load", std::string(), system_sdk_description_file);
+            loaded = dom.load(system_sdk_description_file);
+        }
+        if (!loaded)
+        {
+            throw std::runtime_error(a_util::strings::format("xml parse error for file '%s' : %s",
+                system_sdk_description_file.c_str(),
+                dom.getLastError().c_str()));
+        }
+
+        // Parse data object model
+        bool parsed = false;
+        {
+            TraceScope trace("internalReadConfig", std::string(), system_sdk_description_file);
+            parsed = system_sdk_file.internalReadConfig(dom);
+        }
+        if (!parsed)
+        {
+            throw std::runtime_error(a_util::strings::format("fep sdk system data model parse error for file '%s' : %s",
+                system_sdk_description_file.c_str(),
+                system_sdk_file.getLastError().c_str()));
+        }
+
+        return makeSystemDescription(std::move(system_sdk_file));
+    }
+
+    PropertyTable readPropertyTable(const std::string& system_properties_file)
+    {
+        PropertyFile property_file;
+        a_util::xml::DOM dom;
+        bool loaded = false;
+        {
+            TraceScope trace("dom.load", std::string(), system_properties_file);
+            loaded = dom.load(system_properties_file);
+        }
+        if (!loaded)
+        {
+            throw std::runtime_error(a_util::strings::format("xml parse error for file '%s' : %s",
+                system_properties_file.c_str(),
+                dom.getLastError().c_str()));
+        }
+
+        // Parse data object model
+        bool parsed = false;
+        {
+            TraceScope trace("internalReadConfig", std::string(), system_properties_file);
+            parsed = property_file.internalReadConfig(dom);
+        }
+        if (!parsed)
+        {
+            throw std::runtime_error(a_util::strings::format("fep sdk system properties data model parse error for file '%s' : %s",
+                system_properties_file.c_str(),
+                property_file.getLastError().c_str()));
+        }
+
+        //index the content once, all lookups of the configure path go through the table
+        return makePropertyTable(std::move(property_file));
+    }
+
+    namespace
+    {
+        void checkFileExists(const std::string& file_path)
+        {
+            if (!a_util::filesystem::isFile(file_path))
+            {
+                throw std::runtime_error(a_util::strings::format("The file '%s' does not exist",
+                    file_path.c_str()));
+            }
+        }
+    }
+
+    std::shared_ptr<const SystemDescription> loadSystemDescription(const std::string& system_sdk_description_file)
+    {
+        checkFileExists(system_sdk_description_file);
+
+        auto& parse_cache = ParseCache::getInstance();
+        const auto canonical_path = getCanonicalPath(system_sdk_description_file);
+        FileStamp file_stamp;
+        const bool cacheable = getFileStamp(canonical_path, file_stamp);
+        if (cacheable)
+        {
+            auto cached = parse_cache.findSystemDescription(canonical_path, file_stamp);
+            if (cached)
+            {
+                return cached;
+            }
+        }
+
+        auto system_description = std::make_shared<const SystemDescription>(isSnapshotFile(system_sdk_description_file)
+            ? readSystemDescriptionSnapshot(system_sdk_description_file)
+            : readSystemDescription(system_sdk_description_file));
+        if (cacheable)
+        {
+            parse_cache.store(canonical_path, file_stamp, system_description);
+        }
+        return system_description;
+    }
+
+    std::shared_ptr<const PropertyTable> loadPropertyTable(const std::string& system_properties_file,
+                                                           size_t streaming_parse_threshold)
+    {
+        checkFileExists(system_properties_file);
+
+        auto& parse_cache = ParseCache::getInstance();
+        const auto canonical_path = getCanonicalPath(system_properties_file);
+        FileStamp file_stamp;
+        const bool cacheable = getFileStamp(canonical_path, file_stamp);
+        if (cacheable)
+        {
+            auto cached = parse_cache.findPropertyTable(canonical_path, file_stamp);
+            if (cached)
+            {
+                return cached;
+            }
+        }
+
+        const bool streaming = cacheable && static_cast<uint64_t>(file_stamp._size) >= streaming_parse_threshold;
+        auto property_table = std::make_shared<const PropertyTable>(isSnapshotFile(system_properties_file)
+            ? readPropertyTableSnapshot(system_properties_file)
+            : streaming
+            ? streamPropertyTable(system_properties_file)
+            : readPropertyTable(system_properties_file));
+        if (cacheable)
+        {
+            parse_cache.store(canonical_path, file_stamp, property_table);
+        }
+        return property_table;
+    }
+} // namespace detail
+} // namespace controller
+} // namespace fep3
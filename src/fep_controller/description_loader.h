@@ -0,0 +1,73 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include "property_table.h"
+#include "system_description.h"
+
+#include <memory>
+#include <string>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * Parses the system sdk description file @p system_sdk_description_file.
+     *
+     * @throws std::runtime_error if the file can not be read or parsed
+     */
+    SystemDescription readSystemDescription(const std::string& system_sdk_description_file);
+
+    /**
+     * Parses the system properties file @p system_properties_file.
+     *
+     * @throws std::runtime_error if the file can not be read or parsed
+     */
+    PropertyTable readPropertyTable(const std::string& system_properties_file);
+
+    /**
+     * Parses the system properties file @p system_properties_file from the xml event stream
+     * without building a DOM. The errors are reported the same way as by @ref readPropertyTable.
+     *
+     * @throws std::runtime_error if the file can not be read or parsed
+     */
+    PropertyTable streamPropertyTable(const std::string& system_properties_file);
+
+    /**
+     * Returns the parsed system sdk description file @p system_sdk_description_file,
+     * from the parse cache if the file did not change since it was parsed last.
+     *
+     * @throws std::runtime_error if the file does not exist, can not be read or parsed
+     */
+    std::shared_ptr<const SystemDescription> loadSystemDescription(const std::string& system_sdk_description_file);
+
+    /**
+     * Returns the parsed system properties file @p system_properties_file,
+     * from the parse cache if the file did not change since it was parsed last.
+     * Files of at least @p streaming_parse_threshold bytes are parsed by @ref streamPropertyTable.
+     *
+     * @throws std::runtime_error if the file does not exist, can not be read or parsed
+     */
+    std::shared_ptr<const PropertyTable> loadPropertyTable(const std::string& system_properties_file,
+                                                           size_t streaming_parse_threshold);
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -16,79 +16,59 @@
    @endverbatim
  */
 #include "fep_controller/fep_controller.h"
-#include <fep_metamodel/fep_system.h>
-#include <a_util/xml.h>
 #include <a_util/filesystem.h>
 
 #include <algorithm>
+#include <future>
+#include <map>
+#include <memory>
+#include <set>
+#include <typeindex>
+#include <typeinfo>
 
-using namespace fep::metamodel;
+#include "applied_properties_data.h"
+#include "configuration_node.h"
+#include "configuration_planner.h"
+#include "controller_steps.h"
+#include "description_loader.h"
+#include "fep_system_access.h"
+#include "parallel_for.h"
+#include "progress_reporter.h"
+#include "property_table.h"
+#include "request_runner.h"
+#include "trace_scope.h"
 
 namespace fep3
 {
 namespace controller
 {
-namespace detail
+fep3::System connectSystem(const std::string& system_sdk_description_file)
 {
-    a_util::filesystem::Path normalizeToAnotherPath(const a_util::filesystem::Path& file_reference,
-                                                    const a_util::filesystem::Path& other_file_path)
-    {
-        a_util::filesystem::Path file_path_normalized = file_reference;
-        
-        if (!file_path_normalized.isEmpty())
-        {
-            std::string file_path_normalized_as_string = file_path_normalized;
-            a_util::strings::trim(file_path_normalized_as_string);
-            file_path_normalized = file_path_normalized_as_string;
-            if (file_path_normalized_as_string[0] == '$' && file_path_normalized_as_string[1] == '(')
-            {
-                //this might be a macro at the beginning !! do not change it 
-                //this macro support is for further use!
-                return file_path_normalized;
-            }
-            else
-            {
-                if (file_reference.isRelative())
-                {
-                    file_path_normalized = other_file_path;
-                    file_path_normalized.append(file_reference);
-                }
-                file_path_normalized.makeCanonical();
-                return file_path_normalized;
-            }
-        }
-        else
-        {
-            return file_reference;
-        }
-    }
+    return connectSystem(system_sdk_description_file, ConnectOptions());
 }
 
-fep3::System connectSystem(const std::string& system_sdk_description_file)
+fep3::System connectSystem(const std::string& system_sdk_description_file,
+                           const ConnectOptions& options)
 {   
-    if (!a_util::filesystem::isFile(system_sdk_description_file))
-    {
-        throw std::runtime_error(a_util::strings::format("The file '%s' does not exist",
-            system_sdk_description_file.c_str()));
-    }
+    detail::TraceScope trace("connectSystem", std::string(), system_sdk_description_file);
+    detail::ProgressReporter progress(options._progress_callback, options._cancellation_token);
+    const auto system_description = detail::loadSystemDescription(system_sdk_description_file);
+    progress.report(ProgressStage::parsed, std::string());
 
-    FepSystem system_sdk_file;
-    a_util::xml::DOM dom;
-    if (!dom.load(system_sdk_description_file))
-    {
-        throw std::runtime_error(a_util::strings::format("xml parse error for file '%s' : %s",
-            system_sdk_description_file.c_str(),
-            dom.getLastError().c_str()));
-    }
-
-    // Parse data object model
-    if (!system_sdk_file.internalReadConfig(dom))
-    {
-        throw std::runtime_error(a_util::strings::format("fep sdk system data model parse error for file '%s' : %s",
-            system_sdk_description_file.c_str(),
-            system_sdk_file.getLastError().c_str()));
-    }
+    //every participant refers to one of a few shared timing and mapping files,
+    //so each distinct reference is normalized only once
+    ResolvedPaths call_resolved_paths;
+    ResolvedPaths& resolved_paths = options._resolved_paths ? *options._resolved_paths : call_resolved_paths;
+    return detail::createSystem(*system_description, system_sdk_description_file, resolved_paths, progress);
+}
 
+namespace detail
+{
+fep3::System createSystem(const SystemDescription& system_description,
+                          const std::string& system_sdk_description_file,
+                          ResolvedPaths& resolved_paths,
+                          ProgressReporter& progress)
+{
     //retrieve the Path for the system SDK 
     a_util::filesystem::Path system_sdk_file_path = system_sdk_description_file;
     system_sdk_file_path.makeCanonical();
@@ -99,71 +79,59 @@ fep3::System connectSystem(const std::string& system_sdk_description_file)
         system_sdk_file_path = working_path;
     }
     system_sdk_file_path = system_sdk_file_path.getParent();
+    const std::string system_sdk_directory = system_sdk_file_path;
 
     //create the system
-   fep3::System system(system_sdk_file._name);
+   fep3::System system(system_description._name);
 
-    for (FepParticipant& participant : system_sdk_file._participants)
+    for (const auto& participant : system_description._participants)
     {
-        system.add(participant._element_instance._id);
-        auto part = system.getParticipant(participant._element_instance._id);
-        part.setInitPriority(participant._init_priority);
-        part.setStartPriority(participant._start_priority);
-        //this will save the information for a possible configureSystem call
-        if (participant._element_instance._timing)
+        progress.throwIfCancelled(system_description._name);
         {
-            a_util::filesystem::Path timing_file_reference = participant._element_instance._timing->_file_reference;
-            //if a relative path is used within the file we make it relative to the system_file!!
-            timing_file_reference = detail::normalizeToAnotherPath(timing_file_reference, system_sdk_file_path);
-            part.setAdditionalInfo("timing_file_reference", timing_file_reference);
+            TraceScope trace_add("system.add", participant._name);
+            system.add(participant._name);
         }
-        //this will save the information for a possible configureSystem call
-        if (participant._element_instance._input_mapping)
-        {
-            a_util::filesystem::Path input_mapping = participant._element_instance._input_mapping->_file_reference;
-            //if a relative path is used within the file we make it relative to the system_file!!
-            input_mapping = detail::normalizeToAnotherPath(input_mapping, system_sdk_file_path);
-            part.setAdditionalInfo("input_mapping", input_mapping);
-        }
-        //this will save the information for a possible configureSystem call
-        if (participant._element_instance._output_mapping)
+        auto part = system.getParticipant(participant._name);
+        part.setInitPriority(participant._init_priority);
+        part.setStartPriority(participant._start_priority);
         {
-            a_util::filesystem::Path output_mapping = participant._element_instance._output_mapping->_file_reference;
+            TraceScope trace_normalize("normalizeToAnotherPath", participant._name);
+            //this will save the information for a possible configureSystem call
             //if a relative path is used within the file we make it relative to the system_file!!
-            //I know there are problems when using 
-            output_mapping = detail::normalizeToAnotherPath(output_mapping, system_sdk_file_path);
-            part.setAdditionalInfo("output_mapping", output_mapping);
+            if (participant._timing._valid)
+            {
+                part.setAdditionalInfo("timing_file_reference",
+                    resolved_paths.resolve(participant._timing._file_reference, system_sdk_directory));
+            }
+            if (participant._input_mapping._valid)
+            {
+                part.setAdditionalInfo("input_mapping",
+                    resolved_paths.resolve(participant._input_mapping._file_reference, system_sdk_directory));
+            }
+            if (participant._output_mapping._valid)
+            {
+                part.setAdditionalInfo("output_mapping",
+                    resolved_paths.resolve(participant._output_mapping._file_reference, system_sdk_directory));
+            }
         }
+        progress.report(ProgressStage::connected, participant._name);
     }
 
     return system;
 }
+} // namespace detail
 
-std::string getValueFromProperty(const std::vector<fep::metamodel::Property>& properties,
-    const std::string& key,
-    const std::string& default_value)
-{
-    for (const auto& prop : properties)
-    {
-        if (prop._name == key)
-        {
-            return prop._value;
-        }
-    }
-    return default_value;
-}
-
-void configureSystemTimingFEP3(fep3::System& system,
+void configureSystemTimingFEP3(ISystemAccess& system,
                                 std::string& timing_type,
-                                const std::vector<fep::metamodel::Property>& timing_props)
+                                const detail::PropertyList& timing_props)
 {
     //retrieve the infos master
-    const auto master_element_id = getValueFromProperty(timing_props, "master_element_id", "");
-    const auto master_clock_name = getValueFromProperty(timing_props, "master_clock_name", "local_system_realtime");
-    const auto master_time_stepsize = getValueFromProperty(timing_props, "master_time_stepsize", "100");
-    const auto master_time_factor = getValueFromProperty(timing_props, "master_time_factor", "1.0");
+    const auto master_element_id = timing_props.getValue("master_element_id", "");
+    const auto master_clock_name = timing_props.getValue("master_clock_name", "local_system_realtime");
+    const auto master_time_stepsize = timing_props.getValue("master_time_stepsize", "100");
+    const auto master_time_factor = timing_props.getValue("master_time_factor", "1.0");
     //retrieve the infos slave
-    const auto slave_time_stepsize = getValueFromProperty(timing_props, "slave_time_stepsize", "100");
+    const auto slave_time_stepsize = timing_props.getValue("slave_time_stepsize", "100");
 
     if (timing_type == "Timing3NoMaster")
     {
@@ -193,12 +161,12 @@ void configureSystemTimingFEP3(fep3::System& system,
     }
 }
 
-void configureSystemTiming(fep3::System& system,
-                           const std::vector<fep::metamodel::Property>& timing_props)
+void configureSystemTiming(ISystemAccess& system,
+                           const detail::PropertyList& timing_props)
 {
-    
+    detail::TraceScope trace("configureSystemTiming");
     //have a look into the XSD which type is supported
-    auto timing_type = getValueFromProperty(timing_props, "timing_configuration_type", "PropertyBased");
+    auto timing_type = timing_props.getValue("timing_configuration_type", "PropertyBased");
     if (timing_type == "PropertyBased")
     {
         //we do nothing 
@@ -216,104 +184,1167 @@ void configureSystemTiming(fep3::System& system,
     }
 }
 
-void configureSystemProperties(fep3::System& system, const std::string& system_properties_file)
+std::vector<PropertyWriteError> setPropertiesBatched(const std::shared_ptr<IPropertyBatchWriter>& batch_writer,
+                                                     const std::string& node_path,
+                                                     const detail::PropertyList& properties,
+                                                     const std::string& participant_name,
+                                                     detail::RequestRunner& requests)
 {
-    if (!a_util::filesystem::isFile(system_properties_file))
+    try
     {
-        throw std::runtime_error(a_util::strings::format("The file '%s' does not exist",
-            system_properties_file.c_str()));
+        //the batch writers take the properties as assignments, copied out of the columns once for all attempts
+        const auto assignments = std::make_shared<const std::vector<PropertyAssignment>>(properties.getProperties());
+        return requests.run("setProperties", [batch_writer, node_path, assignments, participant_name]()
+        {
+            detail::TraceScope trace("setProperties", participant_name, node_path);
+            return batch_writer->setProperties(node_path, *assignments);
+        });
+    }
+    catch (const DeadlineExceededError&)
+    {
+        throw;
     }
+    catch (const std::runtime_error& err)
+    {
+        throw std::runtime_error(a_util::strings::format("Unable to set properties '%s' of participant '%s': %s",
+            node_path.c_str(),
+            participant_name.c_str(),
+            err.what()));
+    }
+}
 
-    PropertyFile property_file;
-    a_util::xml::DOM dom;
-    if (!dom.load(system_properties_file))
+ConfigurationFailure makePropertyFailure(const std::string& participant_name,
+                                         const std::string& node_path,
+                                         const detail::PropertyList& properties,
+                                         size_t index,
+                                         const std::string& reason)
+{
+    ConfigurationFailure failure;
+    failure._step = ConfigurationStep::property;
+    failure._participant_name = participant_name;
+    failure._node_path = node_path;
+    failure._property_name = properties.getName(index);
+    failure._type = properties.getType(index);
+    failure._value = properties.getValue(index);
+    failure._reason = reason;
+    return failure;
+}
+
+/**
+ * Throws @p message keeping the type of @p err
+ */
+void rethrowWithMessage(const std::runtime_error& err, const std::string& message)
+{
+    if (dynamic_cast<const DeadlineExceededError*>(&err))
     {
-        throw std::runtime_error(a_util::strings::format("xml parse error for file '%s' : %s",
-            system_properties_file.c_str(),
-            dom.getLastError().c_str()));
+        throw DeadlineExceededError(message);
     }
+    throw std::runtime_error(message);
+}
 
-    // Parse data object model
-    if (!property_file.internalReadConfig(dom))
+/**
+ * Records every property of @p properties as failed
+ */
+void recordPropertyFailures(std::vector<ConfigurationFailure>& failures,
+                            const std::string& participant_name,
+                            const std::string& node_path,
+                            const detail::PropertyList& properties,
+                            const std::string& reason)
+{
+    for (size_t index = 0; index < properties.size(); ++index)
     {
-        throw std::runtime_error(a_util::strings::format("fep sdk system properties data model parse error for file '%s' : %s",
-            system_properties_file.c_str(),
-            property_file.getLastError().c_str()));
+        failures.push_back(makePropertyFailure(participant_name, node_path, properties, index, reason));
     }
+}
 
-    //this will throw is something went wrong
-    system.setSystemState(fep3::SystemAggregatedState::loaded);
+/**
+ * Reports the properties of a batch the participant refused.
+ * They are recorded within @p failures if given, thrown otherwise.
+ */
+void reportWriteErrors(const std::vector<PropertyWriteError>& errors,
+                       const std::string& participant_name,
+                       const std::string& node_path,
+                       const detail::PropertyList& properties,
+                       std::vector<ConfigurationFailure>* failures)
+{
+    if (errors.empty())
+    {
+        return;
+    }
+    std::string message;
+    for (const auto& error : errors)
+    {
+        const std::string property_name = error._index < properties.size()
+            ? properties.getName(error._index)
+            : a_util::strings::toString(static_cast<uint64_t>(error._index));
+        std::string error_message = a_util::strings::format("Error setting property '%s' of participant '%s'.",
+            property_name.c_str(),
+            participant_name.c_str());
+        if (!error._reason.empty())
+        {
+            error_message.append(" ").append(error._reason);
+        }
+        if (failures && error._index < properties.size())
+        {
+            failures->push_back(makePropertyFailure(participant_name, node_path, properties, error._index, error_message));
+        }
+        if (!message.empty())
+        {
+            message.append("\n");
+        }
+        message.append(error_message);
+    }
+    if (!failures)
+    {
+        throw std::runtime_error(message);
+    }
+}
 
-    if (system.getSystemState()._state != fep3::SystemAggregatedState::loaded)
+/**
+ * Sets the properties of a participant by one batch per node.
+ * Failures are recorded within @p failures if given, thrown otherwise.
+ * The indices of the system properties refused by the participant are added to @p refused_system_properties if given.
+ */
+void configureParticipantPropertiesBatched(const std::shared_ptr<IPropertyBatchWriter>& batch_writer,
+                                           const std::string& participant_name,
+                                           const detail::PropertyList& system_properties,
+                                           const detail::PropertyList* element_properties,
+                                           detail::RequestRunner& requests,
+                                           std::vector<ConfigurationFailure>* failures,
+                                           std::vector<size_t>* refused_system_properties)
+{
+    if (!system_properties.empty())
     {
-        throw std::runtime_error(a_util::strings::format("the system %s must be in homogeneous loaded state to configure it!",
-            system.getSystemName().c_str()));
+        try
+        {
+            // errors on system properties are not reported, same as for the single property path
+            const auto errors = setPropertiesBatched(batch_writer, "/system", system_properties, participant_name, requests);
+            for (const auto& error : errors)
+            {
+                if (refused_system_properties && error._index < system_properties.size())
+                {
+                    refused_system_properties->push_back(error._index);
+                }
+            }
+        }
+        catch (const std::runtime_error& err)
+        {
+            if (!failures)
+            {
+                throw;
+            }
+            recordPropertyFailures(*failures, participant_name, "/system", system_properties, err.what());
+        }
     }
-    if (!system.getSystemState()._homogeneous)
+
+    if (element_properties && !element_properties->empty())
     {
-        throw std::runtime_error(a_util::strings::format("the system %s must be in homogeneous loaded state to configure it!",
-            system.getSystemName().c_str()));
+        std::vector<PropertyWriteError> errors;
+        try
+        {
+            errors = setPropertiesBatched(batch_writer, "/", *element_properties, participant_name, requests);
+        }
+        catch (const std::runtime_error& err)
+        {
+            if (!failures)
+            {
+                throw;
+            }
+            recordPropertyFailures(*failures, participant_name, "/", *element_properties, err.what());
+        }
+        reportWriteErrors(errors, participant_name, "/", *element_properties, failures);
     }
-    auto participants = system.getParticipants();
-    for (auto& participant : participants)
+}
+
+/**
+ * Sets the properties of a participant.
+ * Failures are recorded within @p failures if given, thrown otherwise.
+ * A refused system property is no failure, its index is added to @p refused_system_properties if given.
+ */
+void configureParticipantProperties(const std::shared_ptr<IParticipantAccess>& participant,
+                                    const std::shared_ptr<IPropertyBatchWriter>& batch_writer,
+                                    const std::string& participant_name,
+                                    const detail::PropertyList& system_properties,
+                                    const detail::PropertyList* element_properties,
+                                    detail::RequestRunner& requests,
+                                    std::vector<ConfigurationFailure>* failures,
+                                    std::vector<size_t>* refused_system_properties = nullptr)
+{
+    const bool has_element_properties = element_properties && !element_properties->empty();
+    if (system_properties.empty() && !has_element_properties)
+    {
+        //nothing to set, the participant is not contacted at all
+        return;
+    }
+
+    detail::TraceScope trace("configureParticipant", participant_name);
+    if (batch_writer)
+    {
+        configureParticipantPropertiesBatched(batch_writer, participant_name, system_properties, element_properties,
+                                              requests, failures, refused_system_properties);
+        return;
+    }
+
+    try
+    {
+        requests.run("getConfiguration", [participant]() { return participant->getConfiguration(); });
+    }
+    catch (const std::runtime_error& err)
+    {
+        if (!failures)
+        {
+            throw;
+        }
+        recordPropertyFailures(*failures, participant_name, "/system", system_properties, err.what());
+        if (has_element_properties)
+        {
+            recordPropertyFailures(*failures, participant_name, "/", *element_properties, err.what());
+        }
+        return;
+    }
+
+    //sets the property at index of properties, @return false if the participant refused it
+    auto set_property = [&](const std::shared_ptr<detail::ConfigurationNode>& node,
+                            const std::string& node_path,
+                            const detail::PropertyList& properties,
+                            size_t index)
     {
-        auto config_rpc_client = participant.getRPCComponentProxyByIID<fep3::rpc::IRPCConfiguration>();
-        fep3::rpc::IRPCConfiguration& config_rpc_intf = config_rpc_client.getInterface();
-        std::shared_ptr<fep3::IProperties> participant_properties_node;
         try
         {
-            participant_properties_node = config_rpc_intf.getProperties("/");
+            return requests.run("setProperty", [node,
+                                                participant_name,
+                                                name = properties.getName(index),
+                                                value = properties.getValue(index),
+                                                type = properties.getType(index)]()
+            {
+                detail::TraceScope trace_set("setProperty", participant_name, name);
+                return node->call([&](fep3::IProperties& properties_node)
+                {
+                    return properties_node.setProperty(name, value, type);
+                });
+            });
         }
         catch (const std::runtime_error& err)
         {
-            throw std::runtime_error(a_util::strings::format("Unable to access root property: ",
-                err.what()));
+            if (!failures)
+            {
+                throw;
+            }
+            failures->push_back(makePropertyFailure(participant_name, node_path, properties, index, err.what()));
+            //already recorded
+            return true;
         }
-        
-        std::shared_ptr<fep3::IProperties> system_properties_node;
+    };
+
+    if (!system_properties.empty())
+    {
+        const auto system_properties_node = std::make_shared<detail::ConfigurationNode>(participant, "/system");
+        bool fetched = false;
         try
         {
-            system_properties_node = config_rpc_intf.getProperties("/system");
+            fetched = requests.run("getProperties(/system)", [system_properties_node, participant_name]()
+            {
+                detail::TraceScope trace_get("getProperties(/system)", participant_name);
+                system_properties_node->fetch();
+                return true;
+            });
         }
         catch (const std::runtime_error& err)
         {
-            throw std::runtime_error(a_util::strings::format("Unable to access system properties: ",
-                err.what()));
+            const auto message = a_util::strings::format("Unable to access system properties: %s",
+                err.what());
+            if (!failures)
+            {
+                rethrowWithMessage(err, message);
+            }
+            recordPropertyFailures(*failures, participant_name, "/system", system_properties, message);
         }
-        if (system_properties_node)
+        if (fetched)
         {
             // Set system properties
-            for (Property& file_property : property_file._system_properties)
+            for (size_t index = 0; index < system_properties.size(); ++index)
             {
-                system_properties_node->setProperty(file_property._name, file_property._value, file_property._type);
+                if (!set_property(system_properties_node, "/system", system_properties, index)
+                    && refused_system_properties)
+                {
+                    refused_system_properties->push_back(index);
+                }
             }
         }
+    }
 
-        // Find the first element in the property file with the same name as the participant
-        auto it = std::find_if(property_file._element_instances_properties.begin(),
-            property_file._element_instances_properties.end(),
-            [&participant](const PropertyFile::ElementInstance& element) {return element._id == participant.getName();}
-        );
-
-        if (participant_properties_node)
+    if (has_element_properties)
+    {
+        const auto participant_properties_node = std::make_shared<detail::ConfigurationNode>(participant, "/");
+        bool fetched = false;
+        try
+        {
+            fetched = requests.run("getProperties(/)", [participant_properties_node, participant_name]()
+            {
+                detail::TraceScope trace_get("getProperties(/)", participant_name);
+                participant_properties_node->fetch();
+                return true;
+            });
+        }
+        catch (const std::runtime_error& err)
+        {
+            const auto message = a_util::strings::format("Unable to access root property: %s",
+                err.what());
+            if (!failures)
+            {
+                rethrowWithMessage(err, message);
+            }
+            recordPropertyFailures(*failures, participant_name, "/", *element_properties, message);
+        }
+        if (fetched)
         {
             // Set element instance properties
-            if (it != property_file._element_instances_properties.end())
+            for (size_t index = 0; index < element_properties->size(); ++index)
             {
-                for (Property& file_property : it->_properties)
+                if (!set_property(participant_properties_node, "/", *element_properties, index))
                 {
-                    if (!participant_properties_node->setProperty(file_property._name, file_property._value, file_property._type))
+                    const auto message = a_util::strings::format("Error setting property '%s' of participant '%s'.",
+                        element_properties->getName(index).c_str(),
+                        participant_name.c_str());
+                    if (!failures)
                     {
-                        throw std::runtime_error(a_util::strings::format("Error setting property '%s' of participant '%s'.",
-                            file_property._name.c_str(),
-                            participant.getName().c_str()));
+                        throw std::runtime_error(message);
                     }
+                    failures->push_back(makePropertyFailure(participant_name, "/", *element_properties, index, message));
                 }
             }
         }
     }
+}
+
+/**
+ * What is set on one participant
+ */
+struct ParticipantConfiguration
+{
+    std::string _name;
+    const detail::PropertyList* _system_properties = nullptr;
+    const detail::PropertyList* _element_properties = nullptr;
+    std::shared_ptr<IPropertyBatchWriter> _batch_writer;
+};
+
+/**
+ * Plans the requests to @p participant, its batch writer is created by @ref createBatchWriters.
+ * @p broadcast is set if @p system_properties are broadcast.
+ */
+ParticipantConfiguration planParticipant(ConfigurationPlan& plan,
+                                         IParticipantAccess& participant,
+                                         const std::string& participant_name,
+                                         const detail::PropertyList& system_properties,
+                                         const detail::PropertyList* element_properties,
+                                         bool broadcast)
+{
+    ParticipantConfiguration configuration;
+    configuration._name = participant_name;
+    configuration._system_properties = &system_properties;
+    configuration._element_properties = element_properties;
+    plan._participants.push_back(detail::planParticipant(participant_name,
+                                                         system_properties,
+                                                         element_properties,
+                                                         participant.hasBatchWriter(),
+                                                         broadcast));
+    return configuration;
+}
+
+/**
+ * Creates the batch writers of the participants planned as batched with something to set.
+ * Called once the plan is executed, a dry run does not create any writer.
+ * A participant not providing a writer after all is replanned unbatched within its wave,
+ * the corrected plan is handed to the caller again if requested.
+ */
+void createBatchWriters(ConfigurationPlan& plan,
+                        const std::vector<std::shared_ptr<IParticipantAccess>>& participants,
+                        std::vector<ParticipantConfiguration>& configurations,
+                        const ConfigureOptions& options)
+{
+    bool replanned = false;
+    for (size_t index = 0; index < configurations.size(); ++index)
+    {
+        auto& planned = plan._participants[index];
+        if (!planned._batched || planned._round_trips == 0)
+        {
+            continue;
+        }
+        auto& configuration = configurations[index];
+        configuration._batch_writer = participants[index]->getBatchWriter();
+        if (!configuration._batch_writer)
+        {
+            const auto wave = planned._wave;
+            planned = detail::planParticipant(planned._participant_name,
+                                              *configuration._system_properties,
+                                              configuration._element_properties,
+                                              false,
+                                              planned._broadcast);
+            planned._wave = wave;
+            replanned = true;
+        }
+    }
+    if (replanned && options._plan)
+    {
+        *options._plan = plan;
+    }
+}
+
+/**
+ * Assigns the participants of @p plan to waves
+ *
+ * @return the indices of the participants grouped by wave
+ */
+std::vector<std::vector<size_t>> planWaves(ConfigurationPlan& plan,
+                                           const std::vector<std::shared_ptr<IParticipantAccess>>& participants,
+                                           bool priority_waves)
+{
+    std::vector<int32_t> init_priorities(participants.size(), 0);
+    if (priority_waves)
+    {
+        std::transform(participants.begin(), participants.end(), init_priorities.begin(),
+            [](const std::shared_ptr<IParticipantAccess>& participant)
+            {
+                return participant->getInitPriority();
+            });
+    }
+    auto waves = detail::makePriorityWaves(init_priorities);
+    plan._wave_count = waves.size();
+    for (size_t wave = 0; wave < waves.size(); ++wave)
+    {
+        for (const auto index : waves[wave])
+        {
+            plan._participants[index]._wave = wave;
+        }
+    }
+    return waves;
+}
+
+/**
+ * Hands @p plan to the caller if requested
+ *
+ * @return true if the plan should be executed
+ */
+bool publishPlan(const ConfigurationPlan& plan, const ConfigureOptions& options)
+{
+    if (options._plan)
+    {
+        *options._plan = plan;
+    }
+    return !options._dry_run;
+}
 
-    configureSystemTiming(system, property_file._system_timing_properties);
+void configureSystemProperties(fep3::System& system, const std::string& system_properties_file)
+{
+    configureSystemProperties(system, system_properties_file, ConfigureOptions());
+}
+
+void bringSystemToLoaded(ISystemAccess& system,
+                         detail::ProgressReporter& progress,
+                         const detail::OperationDeadline& operation_deadline)
+{
+    progress.throwIfCancelled(system.getSystemName());
+    {
+        detail::TraceScope trace("setSystemState(loaded)");
+        //this will throw is something went wrong
+        system.setSystemState(fep3::SystemAggregatedState::loaded,
+                              operation_deadline.getRemaining("setSystemState(loaded)"));
+    }
+
+    if (system.getSystemState()._state != fep3::SystemAggregatedState::loaded)
+    {
+        throw std::runtime_error(a_util::strings::format("the system %s must be in homogeneous loaded state to configure it!",
+            system.getSystemName().c_str()));
+    }
+    if (!system.getSystemState()._homogeneous)
+    {
+        throw std::runtime_error(a_util::strings::format("the system %s must be in homogeneous loaded state to configure it!",
+            system.getSystemName().c_str()));
+    }
+    for (const auto& participant : system.getParticipants())
+    {
+        progress.report(ProgressStage::loaded, participant->getName());
+    }
+}
+
+/**
+ * Runs a step of the whole system, a failure is recorded within @p report if given
+ *
+ * @return true if the step succeeded
+ */
+template <typename Step>
+bool runSystemStep(ConfigurationStep step, ConfigurationReport* report, Step run_step)
+{
+    try
+    {
+        run_step();
+        return true;
+    }
+    catch (const OperationCancelledError&)
+    {
+        throw;
+    }
+    catch (const std::runtime_error& err)
+    {
+        if (!report)
+        {
+            throw;
+        }
+        ConfigurationFailure failure;
+        failure._step = step;
+        failure._reason = err.what();
+        report->_failures.push_back(failure);
+        return false;
+    }
+}
+
+/**
+ * @return true if the timing was configured
+ */
+bool applySystemTiming(ISystemAccess& system,
+                       const detail::PropertyList& timing_props,
+                       const std::vector<std::shared_ptr<IParticipantAccess>>& participants,
+                       detail::ProgressReporter& progress,
+                       const detail::OperationDeadline& operation_deadline,
+                       ConfigurationReport* report)
+{
+    progress.throwIfCancelled(system.getSystemName());
+    if (!runSystemStep(ConfigurationStep::timing, report, [&]()
+        {
+            operation_deadline.throwIfExpired("configureSystemTiming");
+            configureSystemTiming(system, timing_props);
+        }))
+    {
+        return false;
+    }
+    for (const auto& participant : participants)
+    {
+        progress.report(ProgressStage::timing_applied, participant->getName());
+    }
+    return true;
+}
+
+/**
+ * Loads @p participant right before its properties are set.
+ * A failure is recorded within @p failures if given, together with the properties not set therefore,
+ * thrown otherwise.
+ *
+ * @return true if the participant is loaded
+ */
+bool loadParticipant(const std::shared_ptr<IParticipantAccess>& participant,
+                     const ParticipantConfiguration& configuration,
+                     detail::RequestRunner& requests,
+                     detail::ProgressReporter& progress,
+                     std::vector<ConfigurationFailure>* failures)
+{
+    try
+    {
+        detail::TraceScope trace("load", configuration._name);
+        requests.run("load", [participant]()
+            {
+                participant->load();
+                return true;
+            });
+    }
+    catch (const std::runtime_error& err)
+    {
+        if (!failures)
+        {
+            throw;
+        }
+        ConfigurationFailure failure;
+        failure._step = ConfigurationStep::system_state;
+        failure._participant_name = configuration._name;
+        failure._reason = err.what();
+        failures->push_back(failure);
+        recordPropertyFailures(*failures, configuration._name, "/system", *configuration._system_properties, err.what());
+        if (configuration._element_properties)
+        {
+            recordPropertyFailures(*failures, configuration._name, "/", *configuration._element_properties, err.what());
+        }
+        return false;
+    }
+    progress.report(ProgressStage::loaded, configuration._name);
+    return true;
+}
+
+/**
+ * Sends the broadcast @p system_properties to one participant, as @p serialized_properties if given.
+ * Failures, also refused properties, are recorded within @p failures if given, thrown otherwise.
+ */
+void sendSystemProperties(const std::shared_ptr<IParticipantAccess>& participant,
+                          const ParticipantConfiguration& configuration,
+                          const detail::PropertyList& system_properties,
+                          const std::shared_ptr<const ISerializedProperties>& serialized_properties,
+                          detail::RequestRunner& requests,
+                          std::vector<ConfigurationFailure>* failures)
+{
+    if (!configuration._batch_writer)
+    {
+        //unlike within the single property path, a refused system property fails the participant
+        std::vector<size_t> refused;
+        configureParticipantProperties(participant, nullptr, configuration._name, system_properties, nullptr,
+                                       requests, failures, &refused);
+        std::vector<PropertyWriteError> errors;
+        errors.reserve(refused.size());
+        for (const auto index : refused)
+        {
+            errors.push_back({ index, std::string() });
+        }
+        reportWriteErrors(errors, configuration._name, "/system", system_properties, failures);
+        return;
+    }
+
+    detail::TraceScope trace("broadcastSystemProperties", configuration._name);
+    std::vector<PropertyWriteError> errors;
+    try
+    {
+        const auto assignments = std::make_shared<const std::vector<PropertyAssignment>>(serialized_properties
+            ? std::vector<PropertyAssignment>()
+            : system_properties.getProperties());
+        errors = requests.run("setProperties", [batch_writer = configuration._batch_writer, serialized_properties, assignments]()
+        {
+            return serialized_properties
+                ? batch_writer->setSerializedProperties(*serialized_properties)
+                : batch_writer->setProperties("/system", *assignments);
+        });
+    }
+    catch (const std::runtime_error& err)
+    {
+        const auto message = a_util::strings::format("Unable to set properties '/system' of participant '%s': %s",
+            configuration._name.c_str(),
+            err.what());
+        if (!failures)
+        {
+            rethrowWithMessage(err, message);
+        }
+        recordPropertyFailures(*failures, configuration._name, "/system", system_properties, message);
+        return;
+    }
+    reportWriteErrors(errors, configuration._name, "/system", system_properties, failures);
+}
+
+/**
+ * Serializes @p system_properties once per type of the batch writers within @p configurations,
+ * a payload can only be read by writers of the type which serialized it
+ *
+ * @return the serialized properties per configuration, an empty pointer if its writer does not serialize them
+ */
+std::vector<std::shared_ptr<const ISerializedProperties>> serializeSystemProperties(
+    const std::vector<ParticipantConfiguration>& configurations,
+    const detail::PropertyList& system_properties)
+{
+    std::vector<std::shared_ptr<const ISerializedProperties>> serialized_properties(configurations.size());
+    std::map<std::type_index, std::shared_ptr<const ISerializedProperties>> serialized_by_writer_type;
+    std::vector<PropertyAssignment> assignments;
+    for (size_t index = 0; index < configurations.size(); ++index)
+    {
+        if (!configurations[index]._batch_writer)
+        {
+            continue;
+        }
+        auto& batch_writer = *configurations[index]._batch_writer;
+        const std::type_index writer_type(typeid(batch_writer));
+        auto found = serialized_by_writer_type.find(writer_type);
+        if (found == serialized_by_writer_type.end())
+        {
+            detail::TraceScope trace("serializeSystemProperties");
+            if (assignments.empty())
+            {
+                assignments = system_properties.getProperties();
+            }
+            found = serialized_by_writer_type.emplace(writer_type, batch_writer.serialize("/system", assignments)).first;
+        }
+        serialized_properties[index] = found->second;
+    }
+    return serialized_properties;
+}
+
+/**
+ * Sets the properties of all @p configurations, wave by wave.
+ * If @p load_participants is set, every participant is loaded by its worker first.
+ * If @p broadcast_properties is set, they are sent to every participant within its wave,
+ * before and instead of the system properties of its configuration.
+ * The participant work runs on @p worker_pool if given.
+ * @p succeeded marks every participant configured without failure, also if an error is thrown.
+ * @p refused_system_properties receives the indices of the system properties every participant refused, if given.
+ */
+void configureParticipants(const std::vector<std::shared_ptr<IParticipantAccess>>& participants,
+                           const std::vector<ParticipantConfiguration>& configurations,
+                           const std::vector<std::vector<size_t>>& waves,
+                           bool load_participants,
+                           const detail::PropertyList* broadcast_properties,
+                           const std::string& system_name,
+                           const ConfigureOptions& options,
+                           detail::ProgressReporter& progress,
+                           const detail::OperationDeadline& operation_deadline,
+                           detail::WorkerPool* worker_pool,
+                           std::vector<char>& succeeded,
+                           std::vector<std::vector<size_t>>* refused_system_properties = nullptr)
+{
+    succeeded.assign(participants.size(), 0);
+    if (refused_system_properties)
+    {
+        refused_system_properties->assign(participants.size(), std::vector<size_t>());
+    }
+    const detail::PropertyList no_properties;
+    //the failures are collected per participant, so the report keeps the order of the system
+    std::vector<std::vector<ConfigurationFailure>> failures(options._report ? participants.size() : 0);
+    auto merge_failures = [&]()
+    {
+        for (auto& participant_failures : failures)
+        {
+            options._report->_failures.insert(options._report->_failures.end(),
+                                              participant_failures.begin(),
+                                              participant_failures.end());
+        }
+    };
+    try
+    {
+        const bool broadcast = broadcast_properties && !broadcast_properties->empty();
+        const auto serialized_properties = broadcast
+            ? serializeSystemProperties(configurations, *broadcast_properties)
+            : std::vector<std::shared_ptr<const ISerializedProperties>>();
+
+        //every participant is only touched by one worker, the properties are only read
+        detail::parallelForWaves(waves, options._worker_count, [&](size_t index)
+        {
+            progress.throwIfCancelled(system_name);
+            const auto& configuration = configurations[index];
+            auto participant_failures = options._report ? &failures[index] : nullptr;
+            std::unique_ptr<detail::RequestRunner> requests(new detail::RequestRunner(
+                configuration._name, options._deadlines, options._retry, operation_deadline));
+            if (load_participants
+                && !loadParticipant(participants[index], configuration, *requests, progress, participant_failures))
+            {
+                return;
+            }
+            if (broadcast)
+            {
+                sendSystemProperties(participants[index], configuration, *broadcast_properties,
+                                     serialized_properties[index], *requests, participant_failures);
+                //the participant deadline applies to the element properties separately
+                requests.reset(new detail::RequestRunner(
+                    configuration._name, options._deadlines, options._retry, operation_deadline));
+            }
+            configureParticipantProperties(participants[index],
+                                           configuration._batch_writer,
+                                           configuration._name,
+                                           broadcast_properties ? no_properties : *configuration._system_properties,
+                                           configuration._element_properties,
+                                           *requests,
+                                           participant_failures,
+                                           refused_system_properties ? &(*refused_system_properties)[index] : nullptr);
+            if (!participant_failures || participant_failures->empty())
+            {
+                succeeded[index] = 1;
+                progress.report(ProgressStage::configured, configuration._name);
+            }
+        }, worker_pool);
+    }
+    catch (...)
+    {
+        if (options._report)
+        {
+            merge_failures();
+        }
+        throw;
+    }
+    if (options._report)
+    {
+        merge_failures();
+    }
+}
+
+void configureSystemPropertiesIncremental(ISystemAccess& system,
+                                          const detail::PropertyTable& property_table,
+                                          const ConfigureOptions& options,
+                                          detail::AppliedPropertiesData& applied,
+                                          detail::ProgressReporter& progress,
+                                          const detail::OperationDeadline& operation_deadline,
+                                          detail::WorkerPool* worker_pool)
+{
+    //whatever was recorded for another system is not taken into account
+    const bool same_system = applied._system_name == system.getSystemName();
+    const detail::AppliedPropertiesData nothing_recorded;
+    const auto& recorded = same_system ? applied : nothing_recorded;
+
+    auto participants = system.getParticipants();
+    const bool all_participants_applied = std::all_of(participants.begin(), participants.end(),
+        [&recorded](const std::shared_ptr<IParticipantAccess>& participant)
+        {
+            return recorded._participants.find(participant->getName()) != recorded._participants.end();
+        });
+
+    struct ParticipantChanges
+    {
+        std::string _name;
+        detail::PropertyList _system_properties;
+        detail::PropertyList _element_properties;
+    };
+    std::vector<ParticipantChanges> changes;
+    changes.reserve(participants.size());
+    const detail::AppliedParticipant nothing_applied;
+    for (const auto& participant : participants)
+    {
+        ParticipantChanges participant_changes;
+        participant_changes._name = participant->getName();
+        auto found = recorded._participants.find(participant_changes._name);
+        const auto& applied_participant = found != recorded._participants.end() ? found->second : nothing_applied;
+        participant_changes._system_properties = detail::getChangedProperties(
+            property_table.getSystemProperties(), applied_participant._system_properties);
+        const auto element_properties = property_table.findElementProperties(participant_changes._name);
+        if (element_properties)
+        {
+            participant_changes._element_properties = detail::getChangedProperties(
+                *element_properties, applied_participant._element_properties);
+        }
+        changes.push_back(std::move(participant_changes));
+    }
+    //the system properties can only be broadcast if every participant still needs all of them
+    const auto& system_properties = property_table.getSystemProperties();
+    const bool broadcast = options._broadcast_system_properties
+        && std::all_of(changes.begin(), changes.end(), [&system_properties](const ParticipantChanges& participant_changes)
+            {
+                return participant_changes._system_properties.size() == system_properties.size();
+            });
+
+    ConfigurationPlan plan;
+    plan._system_name = system.getSystemName();
+    plan._load_system = !all_participants_applied;
+    plan._configure_timing = !recorded._timing_applied
+        || !detail::isEqual(recorded._timing_properties, property_table.getSystemTimingProperties());
+    plan._timing_configuration_type = property_table.getSystemTimingProperties().getValue("timing_configuration_type",
+                                                                                          "PropertyBased");
+    std::vector<ParticipantConfiguration> configurations;
+    configurations.reserve(participants.size());
+    for (size_t index = 0; index < participants.size(); ++index)
+    {
+        configurations.push_back(planParticipant(plan, *participants[index], changes[index]._name,
+                                                 changes[index]._system_properties,
+                                                 &changes[index]._element_properties,
+                                                 broadcast));
+    }
+    const auto waves = planWaves(plan, participants, options._priority_waves);
+    if (!publishPlan(plan, options))
+    {
+        return;
+    }
+    createBatchWriters(plan, participants, configurations, options);
+
+    if (!same_system)
+    {
+        applied = detail::AppliedPropertiesData();
+        applied._system_name = system.getSystemName();
+    }
+    const bool load_participants = plan._load_system && options._load_participants;
+    if (plan._load_system && !load_participants)
+    {
+        runSystemStep(ConfigurationStep::system_state, options._report, [&]()
+        {
+            bringSystemToLoaded(system, progress, operation_deadline);
+        });
+    }
+
+    //the workers only mark their participant, the records are updated afterwards on this thread
+    std::vector<char> succeeded;
+    //a refused system property is no failure, but it is not applied either
+    std::vector<std::vector<size_t>> refused_system_properties;
+    auto record_succeeded = [&]()
+    {
+        for (size_t index = 0; index < succeeded.size(); ++index)
+        {
+            if (succeeded[index])
+            {
+                auto& applied_participant = applied._participants[changes[index]._name];
+                detail::recordAppliedProperties(applied_participant._system_properties, changes[index]._system_properties,
+                                                refused_system_properties[index]);
+                detail::recordAppliedProperties(applied_participant._element_properties, changes[index]._element_properties);
+            }
+        }
+    };
+    try
+    {
+        configureParticipants(participants, configurations, waves, load_participants,
+                              broadcast ? &system_properties : nullptr, applied._system_name,
+                              options, progress, operation_deadline, worker_pool, succeeded, &refused_system_properties);
+    }
+    catch (...)
+    {
+        record_succeeded();
+        throw;
+    }
+    record_succeeded();
+
+    if (plan._configure_timing
+        && applySystemTiming(system, property_table.getSystemTimingProperties(), participants,
+                             progress, operation_deadline, options._report))
+    {
+        applied._timing_properties = property_table.getSystemTimingProperties();
+        applied._timing_applied = true;
+    }
+}
+
+/**
+ * @return the properties of @p properties named within @p names
+ */
+detail::PropertyList selectProperties(const detail::PropertyList& properties, const std::set<std::string>& names)
+{
+    detail::PropertyListBuilder selected;
+    for (size_t index = 0; index < properties.size(); ++index)
+    {
+        if (names.find(properties.getName(index)) != names.end())
+        {
+            selected.add(properties.getName(index), properties.getType(index), properties.getValue(index));
+        }
+    }
+    return selected.finishList();
+}
+
+void configureSystemPropertiesRetry(ISystemAccess& system,
+                                    const detail::PropertyTable& property_table,
+                                    const ConfigurationReport& retry_report,
+                                    const ConfigureOptions& options,
+                                    detail::ProgressReporter& progress,
+                                    const detail::OperationDeadline& operation_deadline,
+                                    detail::WorkerPool* worker_pool)
+{
+    if (retry_report._system_name != system.getSystemName())
+    {
+        throw std::runtime_error(a_util::strings::format("the report to retry belongs to system %s, not to system %s",
+            retry_report._system_name.c_str(),
+            system.getSystemName().c_str()));
+    }
+
+    ConfigurationPlan plan;
+    plan._system_name = system.getSystemName();
+    plan._timing_configuration_type = property_table.getSystemTimingProperties().getValue("timing_configuration_type",
+                                                                                          "PropertyBased");
+    //names of the failed system and element properties per participant
+    std::map<std::string, std::pair<std::set<std::string>, std::set<std::string>>> failed_properties;
+    for (const auto& failure : retry_report._failures)
+    {
+        switch (failure._step)
+        {
+        case ConfigurationStep::system_state:
+            plan._load_system = true;
+            break;
+        case ConfigurationStep::timing:
+            plan._configure_timing = true;
+            break;
+        default:
+            auto& failed = failed_properties[failure._participant_name];
+            (failure._node_path == "/system" ? failed.first : failed.second).insert(failure._property_name);
+            break;
+        }
+    }
+
+    auto participants = system.getParticipants();
+    //the values are taken from the properties file, failed properties no longer within the file are dropped
+    std::vector<detail::PropertyList> system_properties(participants.size());
+    std::vector<detail::PropertyList> element_properties(participants.size());
+    std::vector<ParticipantConfiguration> configurations;
+    configurations.reserve(participants.size());
+    for (size_t index = 0; index < participants.size(); ++index)
+    {
+        const auto participant_name = participants[index]->getName();
+        auto found = failed_properties.find(participant_name);
+        if (found != failed_properties.end())
+        {
+            system_properties[index] = selectProperties(property_table.getSystemProperties(), found->second.first);
+            const auto file_element_properties = property_table.findElementProperties(participant_name);
+            if (file_element_properties)
+            {
+                element_properties[index] = selectProperties(*file_element_properties, found->second.second);
+            }
+        }
+        configurations.push_back(planParticipant(plan, *participants[index], participant_name,
+                                                 system_properties[index], &element_properties[index], false));
+    }
+    const auto waves = planWaves(plan, participants, options._priority_waves);
+    if (!publishPlan(plan, options))
+    {
+        return;
+    }
+    createBatchWriters(plan, participants, configurations, options);
+
+    const bool load_participants = plan._load_system && options._load_participants;
+    if (plan._load_system && !load_participants)
+    {
+        runSystemStep(ConfigurationStep::system_state, options._report, [&]()
+        {
+            bringSystemToLoaded(system, progress, operation_deadline);
+        });
+    }
+    std::vector<char> succeeded;
+    configureParticipants(participants, configurations, waves, load_participants, nullptr, plan._system_name,
+                          options, progress, operation_deadline, worker_pool, succeeded);
+    if (plan._configure_timing)
+    {
+        applySystemTiming(system, property_table.getSystemTimingProperties(), participants,
+                          progress, operation_deadline, options._report);
+    }
+}
+
+void configureSystemProperties(fep3::System& system,
+                               const std::string& system_properties_file,
+                               const ConfigureOptions& options)
+{
+    detail::FepSystemAccess system_access(system, options._batch_writer_factory);
+    configureSystemProperties(system_access, system_properties_file, options);
+}
+
+void configureSystemProperties(ISystemAccess& system,
+                               const std::string& system_properties_file,
+                               const ConfigureOptions& options)
+{
+    detail::TraceScope trace("configureSystemProperties", std::string(), system_properties_file);
+    const detail::OperationDeadline operation_deadline(options._deadlines._operation_deadline);
+    const auto property_table = detail::loadPropertyTable(system_properties_file,
+                                                          options._streaming_parse_threshold);
+    detail::ProgressReporter progress(options._progress_callback, options._cancellation_token);
+    progress.report(ProgressStage::parsed, std::string());
+    detail::configureSystemProperties(system, *property_table, options, progress, operation_deadline);
+}
+
+namespace detail
+{
+void configureSystemProperties(ISystemAccess& system,
+                               const PropertyTable& property_table,
+                               const ConfigureOptions& options,
+                               ProgressReporter& progress,
+                               const OperationDeadline& operation_deadline,
+                               WorkerPool* worker_pool)
+{
+    //the report to retry might be the report to fill
+    ConfigurationReport retry_report;
+    if (options._retry_report)
+    {
+        retry_report = *options._retry_report;
+    }
+    if (options._report && !options._dry_run)
+    {
+        options._report->_system_name = system.getSystemName();
+        options._report->_failures.clear();
+    }
+
+    if (options._retry_report)
+    {
+        configureSystemPropertiesRetry(system, property_table, retry_report, options, progress, operation_deadline,
+                                       worker_pool);
+        return;
+    }
+    if (options._applied_properties)
+    {
+        configureSystemPropertiesIncremental(system,
+                                             property_table,
+                                             options,
+                                             detail::AppliedPropertiesAccess::get(*options._applied_properties),
+                                             progress,
+                                             operation_deadline,
+                                             worker_pool);
+        return;
+    }
+
+    //plan the requests before any participant is contacted
+    auto participants = system.getParticipants();
+    ConfigurationPlan plan;
+    plan._system_name = system.getSystemName();
+    plan._load_system = true;
+    plan._configure_timing = true;
+    plan._timing_configuration_type = property_table.getSystemTimingProperties().getValue("timing_configuration_type",
+                                                                                          "PropertyBased");
+    std::vector<ParticipantConfiguration> configurations;
+    configurations.reserve(participants.size());
+    for (const auto& participant : participants)
+    {
+        const auto participant_name = participant->getName();
+        configurations.push_back(planParticipant(plan, *participant, participant_name,
+                                                 property_table.getSystemProperties(),
+                                                 property_table.findElementProperties(participant_name),
+                                                 options._broadcast_system_properties));
+    }
+    const auto waves = planWaves(plan, participants, options._priority_waves);
+    if (!publishPlan(plan, options))
+    {
+        return;
+    }
+    createBatchWriters(plan, participants, configurations, options);
+
+    if (!options._load_participants)
+    {
+        runSystemStep(ConfigurationStep::system_state, options._report, [&]()
+            {
+                bringSystemToLoaded(system, progress, operation_deadline);
+            });
+    }
+    std::vector<char> succeeded;
+    configureParticipants(participants, configurations, waves, options._load_participants,
+                          options._broadcast_system_properties ? &property_table.getSystemProperties() : nullptr,
+                          plan._system_name, options, progress, operation_deadline, worker_pool, succeeded);
+    applySystemTiming(system, property_table.getSystemTimingProperties(), participants,
+                          progress, operation_deadline, options._report);
+}
+} // namespace detail
+
+fep3::System bringUpSystem(const std::string& system_sdk_description_file,
+                           const std::string& system_properties_file,
+                           const BringUpOptions& options)
+{
+    detail::TraceScope trace("bringUpSystem", std::string(), system_sdk_description_file);
+    ConfigureOptions configure_options = options._configure_options;
+    configure_options._load_participants = true;
+    const detail::OperationDeadline operation_deadline(configure_options._deadlines._operation_deadline);
+
+    //the properties file is parsed while the system is connected
+    auto property_table_future = std::async(std::launch::async,
+        [&system_properties_file, &configure_options]()
+        {
+            detail::TraceScope trace_parse("loadPropertyTable", std::string(), system_properties_file);
+            return detail::loadPropertyTable(system_properties_file, configure_options._streaming_parse_threshold);
+        });
+
+    detail::ProgressReporter connect_progress(options._connect_options._progress_callback,
+                                              options._connect_options._cancellation_token);
+    const auto system_description = detail::loadSystemDescription(system_sdk_description_file);
+    connect_progress.report(ProgressStage::parsed, std::string());
+    ResolvedPaths call_resolved_paths;
+    ResolvedPaths& resolved_paths = options._connect_options._resolved_paths
+        ? *options._connect_options._resolved_paths
+        : call_resolved_paths;
+    auto system = detail::createSystem(*system_description, system_sdk_description_file, resolved_paths, connect_progress);
+
+    const auto property_table = property_table_future.get();
+    detail::ProgressReporter configure_progress(configure_options._progress_callback,
+                                                configure_options._cancellation_token);
+    configure_progress.report(ProgressStage::parsed, std::string());
+    {
+        detail::FepSystemAccess system_access(system, configure_options._batch_writer_factory);
+        detail::configureSystemProperties(system_access, *property_table, configure_options,
+                                          configure_progress, operation_deadline);
+    }
+    return system;
+}
+
+std::future<fep3::System> connectSystemAsync(const std::string& system_sdk_description_file,
+                                             ConnectOptions options)
+{
+    return std::async(std::launch::async,
+        [system_sdk_description_file, options]()
+        {
+            return connectSystem(system_sdk_description_file, options);
+        });
+}
+
+std::future<void> configureSystemPropertiesAsync(fep3::System& system,
+                                                 const std::string& system_properties_file,
+                                                 ConfigureOptions options)
+{
+    return std::async(std::launch::async,
+        [&system, system_properties_file, options]()
+        {
+            configureSystemProperties(system, system_properties_file, options);
+        });
 }
 }
 }
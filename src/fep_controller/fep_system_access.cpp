@@ -0,0 +1,206 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "fep_system_access.h"
+#include <a_util/strings.h>
+
+#include <mutex>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    class FepParticipantAccess : public IParticipantAccess
+    {
+    public:
+        FepParticipantAccess(const fep3::ParticipantProxy& participant,
+                             const PropertyBatchWriterFactory& batch_writer_factory)
+            : _participant(participant),
+              _batch_writer_factory(batch_writer_factory)
+        {
+        }
+
+        std::string getName() const override
+        {
+            return _participant.getName();
+        }
+
+        int32_t getInitPriority() const override
+        {
+            return _participant.getInitPriority();
+        }
+
+        std::shared_ptr<fep3::rpc::IRPCConfiguration> getConfiguration() override
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_configuration)
+                {
+                    return _configuration;
+                }
+            }
+            //the proxy is created without holding the lock, a stalled lookup must not block the others
+            using ConfigurationClient = decltype(_participant.getRPCComponentProxyByIID<fep3::rpc::IRPCConfiguration>());
+            auto config_rpc_client = std::make_shared<ConfigurationClient>(
+                _participant.getRPCComponentProxyByIID<fep3::rpc::IRPCConfiguration>());
+            fep3::rpc::IRPCConfiguration& config_rpc_intf = config_rpc_client->getInterface();
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_configuration)
+            {
+                //the interface keeps its client alive
+                _configuration = std::shared_ptr<fep3::rpc::IRPCConfiguration>(config_rpc_client, &config_rpc_intf);
+            }
+            return _configuration;
+        }
+
+        void dropConfiguration(const std::shared_ptr<fep3::rpc::IRPCConfiguration>& configuration) override
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            //a proxy created meanwhile by another request is kept
+            if (_configuration == configuration)
+            {
+                _configuration.reset();
+            }
+        }
+
+        std::shared_ptr<IPropertyBatchWriter> getBatchWriter() override
+        {
+            if (_batch_writer_factory)
+            {
+                return _batch_writer_factory(_participant);
+            }
+            return {};
+        }
+
+        bool hasBatchWriter() const override
+        {
+            return static_cast<bool>(_batch_writer_factory);
+        }
+
+        void load() override
+        {
+            using State = fep3::rpc::IRPCParticipantStateMachine::State;
+            auto state_machine = _participant.getRPCComponentProxyByIID<fep3::rpc::IRPCParticipantStateMachine>();
+            if (!state_machine)
+            {
+                throw std::runtime_error(a_util::strings::format("the participant %s can not be reached",
+                    _participant.getName().c_str()));
+            }
+            if (state_machine->getState() == State::unloaded)
+            {
+                state_machine->load();
+            }
+            if (state_machine->getState() != State::loaded)
+            {
+                throw std::runtime_error(a_util::strings::format("the participant %s must be in loaded state to configure it!",
+                    _participant.getName().c_str()));
+            }
+        }
+
+    private:
+        fep3::ParticipantProxy _participant;
+        const PropertyBatchWriterFactory& _batch_writer_factory;
+        std::mutex _mutex;
+        std::shared_ptr<fep3::rpc::IRPCConfiguration> _configuration;
+    };
+
+    FepSystemAccess::FepSystemAccess(fep3::System& system, const PropertyBatchWriterFactory& batch_writer_factory)
+        : _system(system),
+          _batch_writer_factory(batch_writer_factory)
+    {
+    }
+
+    std::string FepSystemAccess::getSystemName() const
+    {
+        return _system.getSystemName();
+    }
+
+    std::vector<std::shared_ptr<IParticipantAccess>> FepSystemAccess::getParticipants()
+    {
+        std::vector<std::shared_ptr<IParticipantAccess>> participants;
+        std::map<std::string, std::shared_ptr<FepParticipantAccess>> known_participants;
+        for (const auto& participant : _system.getParticipants())
+        {
+            //participants removed from the system are dropped, added ones are accessed on first use
+            const auto participant_name = participant.getName();
+            auto found = _participants.find(participant_name);
+            auto access = found != _participants.end()
+                ? found->second
+                : std::make_shared<FepParticipantAccess>(participant, _batch_writer_factory);
+            known_participants[participant_name] = access;
+            participants.push_back(access);
+        }
+        _participants.swap(known_participants);
+        return participants;
+    }
+
+    void FepSystemAccess::setSystemState(fep3::SystemAggregatedState state, std::chrono::milliseconds timeout)
+    {
+        if (timeout.count() > 0)
+        {
+            _system.setSystemState(state, timeout);
+        }
+        else
+        {
+            _system.setSystemState(state);
+        }
+    }
+
+    void FepSystemAccess::setBatchWriterFactory(const PropertyBatchWriterFactory& batch_writer_factory)
+    {
+        _batch_writer_factory = batch_writer_factory;
+    }
+
+    fep3::SystemState FepSystemAccess::getSystemState()
+    {
+        return _system.getSystemState();
+    }
+
+    void FepSystemAccess::configureTiming3NoMaster()
+    {
+        _system.configureTiming3NoMaster();
+    }
+
+    void FepSystemAccess::configureTiming3ClockSyncOnlyInterpolation(const std::string& master_element_id,
+                                                                     const std::string& slave_sync_cycle_time)
+    {
+        _system.configureTiming3ClockSyncOnlyInterpolation(master_element_id, slave_sync_cycle_time);
+    }
+
+    void FepSystemAccess::configureTiming3ClockSyncOnlyDiscrete(const std::string& master_element_id,
+                                                                const std::string& slave_sync_cycle_time)
+    {
+        _system.configureTiming3ClockSyncOnlyDiscrete(master_element_id, slave_sync_cycle_time);
+    }
+
+    void FepSystemAccess::configureTiming3DiscreteSteps(const std::string& master_element_id,
+                                                        const std::string& master_time_stepsize,
+                                                        const std::string& master_time_factor)
+    {
+        _system.configureTiming3DiscreteSteps(master_element_id, master_time_stepsize, master_time_factor);
+    }
+
+    void FepSystemAccess::configureTiming3AFAP(const std::string& master_element_id,
+                                               const std::string& master_time_stepsize)
+    {
+        _system.configureTiming3AFAP(master_element_id, master_time_stepsize);
+    }
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,74 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/system_access_intf.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    class FepParticipantAccess;
+
+    /**
+     * Accesses the participants of a fep3::System via the service bus.
+     * The batch writers are created by @p batch_writer_factory (if set).
+     * The access to a participant and its configuration RPC proxy are created on first use
+     * and reused as long as this object lives. A configuration proxy a request failed on
+     * is dropped (see @ref IParticipantAccess::dropConfiguration) and created anew on next use.
+     */
+    class FepSystemAccess : public ISystemAccess
+    {
+    public:
+        FepSystemAccess(fep3::System& system, const PropertyBatchWriterFactory& batch_writer_factory);
+
+        std::string getSystemName() const override;
+        std::vector<std::shared_ptr<IParticipantAccess>> getParticipants() override;
+        void setSystemState(fep3::SystemAggregatedState state, std::chrono::milliseconds timeout) override;
+        fep3::SystemState getSystemState() override;
+
+        void configureTiming3NoMaster() override;
+        void configureTiming3ClockSyncOnlyInterpolation(const std::string& master_element_id,
+                                                        const std::string& slave_sync_cycle_time) override;
+        void configureTiming3ClockSyncOnlyDiscrete(const std::string& master_element_id,
+                                                   const std::string& slave_sync_cycle_time) override;
+        void configureTiming3DiscreteSteps(const std::string& master_element_id,
+                                           const std::string& master_time_stepsize,
+                                           const std::string& master_time_factor) override;
+        void configureTiming3AFAP(const std::string& master_element_id,
+                                  const std::string& master_time_stepsize) override;
+
+        /**
+         * Replaces the factory of the batch writers, used by the participants from now on
+         */
+        void setBatchWriterFactory(const PropertyBatchWriterFactory& batch_writer_factory);
+
+    private:
+        fep3::System& _system;
+        PropertyBatchWriterFactory _batch_writer_factory;
+        std::map<std::string, std::shared_ptr<FepParticipantAccess>> _participants;
+    };
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,200 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "file_watch.h"
+
+#include <a_util/strings.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+#ifdef __linux__
+    FileWatch::FileWatch(const std::string& file_path,
+                         std::chrono::milliseconds debounce,
+                         std::chrono::milliseconds /*poll_interval*/)
+        : _file_path(getCanonicalPath(file_path)),
+          _debounce(debounce)
+    {
+        const auto separator = _file_path.rfind('/');
+        const std::string directory = separator == 0 ? "/" : _file_path.substr(0, separator);
+        _file_name = _file_path.substr(separator + 1);
+
+        _inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        _stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_inotify_fd < 0
+            || _stop_fd < 0
+            || inotify_add_watch(_inotify_fd, directory.c_str(),
+                                 IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE) < 0)
+        {
+            const std::string reason = std::strerror(errno);
+            if (_inotify_fd >= 0)
+            {
+                ::close(_inotify_fd);
+            }
+            if (_stop_fd >= 0)
+            {
+                ::close(_stop_fd);
+            }
+            throw std::runtime_error(a_util::strings::format("the file %s can not be watched: %s",
+                file_path.c_str(), reason.c_str()));
+        }
+    }
+
+    FileWatch::~FileWatch()
+    {
+        ::close(_inotify_fd);
+        ::close(_stop_fd);
+    }
+
+    bool FileWatch::readEvents()
+    {
+        alignas(inotify_event) char buffer[4096];
+        bool changed = false;
+        for (;;)
+        {
+            const auto length = ::read(_inotify_fd, buffer, sizeof(buffer));
+            if (length <= 0)
+            {
+                return changed;
+            }
+            for (const char* position = buffer; position < buffer + length;)
+            {
+                const auto event = reinterpret_cast<const inotify_event*>(position);
+                if (event->len > 0 && _file_name == event->name)
+                {
+                    changed = true;
+                }
+                position += sizeof(inotify_event) + event->len;
+            }
+        }
+    }
+
+    bool FileWatch::waitForChange()
+    {
+        using Clock = std::chrono::steady_clock;
+        bool changed = false;
+        Clock::time_point last_change;
+        for (;;)
+        {
+            int timeout = -1;
+            if (changed)
+            {
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    last_change + _debounce - Clock::now());
+                timeout = remaining.count() > 0 ? static_cast<int>(remaining.count()) : 0;
+            }
+            pollfd fds[2] = { { _stop_fd, POLLIN, 0 }, { _inotify_fd, POLLIN, 0 } };
+            const int ready = ::poll(fds, 2, timeout);
+            if (ready < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::runtime_error(a_util::strings::format("waiting for changes of the file %s failed: %s",
+                    _file_path.c_str(), std::strerror(errno)));
+            }
+            if (fds[0].revents & POLLIN)
+            {
+                return false;
+            }
+            if ((fds[1].revents & POLLIN) && readEvents())
+            {
+                //every change restarts the debounce time
+                changed = true;
+                last_change = Clock::now();
+            }
+            else if (changed && Clock::now() >= last_change + _debounce)
+            {
+                return true;
+            }
+        }
+    }
+
+    void FileWatch::stop()
+    {
+        //the counter stays set, so later waits return at once
+        const uint64_t value = 1;
+        if (::write(_stop_fd, &value, sizeof(value)) < 0)
+        {
+            //only fails if the counter overflows, it is set in that case anyway
+        }
+    }
+#else
+    FileWatch::FileWatch(const std::string& file_path,
+                         std::chrono::milliseconds debounce,
+                         std::chrono::milliseconds poll_interval)
+        : _file_path(getCanonicalPath(file_path)),
+          _debounce(debounce),
+          _poll_interval(poll_interval)
+    {
+        getFileStamp(_file_path, _file_stamp);
+    }
+
+    FileWatch::~FileWatch() = default;
+
+    bool FileWatch::waitForChange()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        bool changed = false;
+        FileStamp changed_stamp;
+        for (;;)
+        {
+            if (_stop_condition.wait_for(lock, changed ? _debounce : _poll_interval, [this]() { return _stopped; }))
+            {
+                return false;
+            }
+            //a file which can not be accessed (e.g. while it is replaced) counts as changed
+            FileStamp file_stamp;
+            getFileStamp(_file_path, file_stamp);
+            if (!(file_stamp == (changed ? changed_stamp : _file_stamp)))
+            {
+                changed = true;
+                changed_stamp = file_stamp;
+            }
+            else if (changed)
+            {
+                _file_stamp = file_stamp;
+                return true;
+            }
+        }
+    }
+
+    void FileWatch::stop()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+        _stop_condition.notify_all();
+    }
+#endif
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,89 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include "parse_cache.h"
+
+#include <chrono>
+#include <string>
+
+#ifndef __linux__
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * Waits for changes of one file.
+     * On Linux the directory of the file is watched by inotify, so a file replaced by an editor
+     * (written to a temporary file and renamed) is noticed as well.
+     * Elsewhere the size and modification time of the file are polled.
+     */
+    class FileWatch
+    {
+    public:
+        /**
+         * @param [in] file_path the file to watch
+         * @param [in] debounce the time the file has to stay unchanged before a change is reported
+         * @param [in] poll_interval the polling interval where inotify is not available
+         * @throws std::runtime_error if the file can not be watched
+         */
+        FileWatch(const std::string& file_path,
+                  std::chrono::milliseconds debounce,
+                  std::chrono::milliseconds poll_interval);
+        ~FileWatch();
+        FileWatch(const FileWatch&) = delete;
+        FileWatch& operator=(const FileWatch&) = delete;
+
+        /**
+         * Blocks until the file changed and then did not change for the debounce time
+         *
+         * @return false if @ref stop was called
+         * @throws std::runtime_error if waiting failed
+         */
+        bool waitForChange();
+        /**
+         * Makes the current and every later @ref waitForChange return false, may be called from any thread
+         */
+        void stop();
+
+    private:
+        const std::string _file_path;
+        const std::chrono::milliseconds _debounce;
+#ifdef __linux__
+        bool readEvents();
+
+        std::string _file_name;
+        int _inotify_fd = -1;
+        int _stop_fd = -1;
+#else
+        const std::chrono::milliseconds _poll_interval;
+        std::mutex _mutex;
+        std::condition_variable _stop_condition;
+        bool _stopped = false;
+        FileStamp _file_stamp;
+#endif
+    };
+} // namespace detail
+} // namespace controller
+} // namespace fep3
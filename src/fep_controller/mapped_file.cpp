@@ -0,0 +1,152 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "mapped_file.h"
+
+#include <a_util/strings.h>
+
+#include <stdexcept>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+#ifdef WIN32
+    MappedFile::MappedFile(const std::string& file_path)
+    {
+        auto fail = [&](const char* action)
+        {
+            const auto error = GetLastError();
+            if (_mapping)
+            {
+                CloseHandle(_mapping);
+            }
+            if (_file && _file != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(_file);
+            }
+            throw std::runtime_error(a_util::strings::format("the file '%s' can not be %s (error %lu)",
+                file_path.c_str(), action, static_cast<unsigned long>(error)));
+        };
+        _file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (_file == INVALID_HANDLE_VALUE)
+        {
+            fail("opened");
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(_file, &file_size))
+        {
+            fail("opened");
+        }
+        _size = static_cast<size_t>(file_size.QuadPart);
+        if (_size == 0)
+        {
+            return;
+        }
+        _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!_mapping)
+        {
+            fail("mapped");
+        }
+        _data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!_data)
+        {
+            fail("mapped");
+        }
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (_data)
+        {
+            UnmapViewOfFile(_data);
+        }
+        if (_mapping)
+        {
+            CloseHandle(_mapping);
+        }
+        CloseHandle(_file);
+    }
+#else
+    MappedFile::MappedFile(const std::string& file_path)
+    {
+        const int fd = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::runtime_error(a_util::strings::format("the file '%s' can not be opened: %s",
+                file_path.c_str(), std::strerror(errno)));
+        }
+        struct stat file_status;
+        if (::fstat(fd, &file_status) != 0)
+        {
+            const std::string reason = std::strerror(errno);
+            ::close(fd);
+            throw std::runtime_error(a_util::strings::format("the file '%s' can not be opened: %s",
+                file_path.c_str(), reason.c_str()));
+        }
+        _size = static_cast<size_t>(file_status.st_size);
+        if (_size > 0)
+        {
+            void* data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                const std::string reason = std::strerror(errno);
+                ::close(fd);
+                throw std::runtime_error(a_util::strings::format("the file '%s' can not be mapped: %s",
+                    file_path.c_str(), reason.c_str()));
+            }
+            _data = static_cast<const char*>(data);
+        }
+        //the mapping stays valid without the descriptor
+        ::close(fd);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (_data)
+        {
+            ::munmap(const_cast<char*>(_data), _size);
+        }
+    }
+#endif
+
+    const char* MappedFile::getData() const
+    {
+        return _data;
+    }
+
+    size_t MappedFile::getSize() const
+    {
+        return _size;
+    }
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,59 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * A file mapped read-only into memory for the lifetime of the object
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @param [in] file_path the file to map
+         * @throws std::runtime_error if the file can not be opened or mapped
+         */
+        explicit MappedFile(const std::string& file_path);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /// @return the content of the file, nullptr if the file is empty
+        const char* getData() const;
+        /// @return the size of the file in bytes
+        size_t getSize() const;
+
+    private:
+        const char* _data = nullptr;
+        size_t _size = 0;
+#ifdef WIN32
+        void* _file = nullptr;
+        void* _mapping = nullptr;
+#endif
+    };
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,186 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * Calls @p task for every index in [0, @p count) using up to @p worker_count threads.
+     *
+     * If a task throws, no further indices are handed out and the exception of the
+     * lowest failing index is rethrown once all running tasks have returned.
+     * So the caller sees the same error a serial loop would have reported first.
+     *
+     * If @p worker_pool is given, the workers are posted to the pool and the calling thread only waits,
+     * so the tasks of all callers sharing the pool are bounded by its threads.
+     *
+     * @param [in] count number of work items
+     * @param [in] worker_count maximum number of concurrent tasks (0 and 1 run serially on the calling thread,
+     *                          or on one thread of @p worker_pool)
+     * @param [in] task the work item callback, called with the index of the item
+     * @param [in] worker_pool the pool to run the workers on, nullptr to start threads for this call
+     *
+     * @throws std::system_error if a thread can not be started, after the started ones have returned
+     */
+    inline void parallelFor(size_t count,
+                            size_t worker_count,
+                            const std::function<void(size_t)>& task,
+                            WorkerPool* worker_pool = nullptr)
+    {
+        if (!worker_pool && (worker_count <= 1 || count <= 1))
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                task(index);
+            }
+            return;
+        }
+        if (count == 0)
+        {
+            return;
+        }
+
+        std::atomic<size_t> next_index{ 0 };
+        std::atomic<bool> failed{ false };
+        std::vector<std::exception_ptr> errors(count);
+
+        auto worker = [&]()
+        {
+            while (!failed)
+            {
+                const size_t index = next_index++;
+                if (index >= count)
+                {
+                    return;
+                }
+                try
+                {
+                    task(index);
+                }
+                catch (...)
+                {
+                    errors[index] = std::current_exception();
+                    failed = true;
+                }
+            }
+        };
+
+        const size_t thread_count = std::min(std::max<size_t>(worker_count, 1), count);
+        if (worker_pool)
+        {
+            std::mutex mutex;
+            std::condition_variable finished;
+            size_t running = thread_count;
+            for (size_t thread_index = 0; thread_index < thread_count; ++thread_index)
+            {
+                worker_pool->post([&]()
+                {
+                    worker();
+                    //notified under the lock, so the caller can not return before
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (--running == 0)
+                    {
+                        finished.notify_all();
+                    }
+                });
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [&running]() { return running == 0; });
+        }
+        else
+        {
+            std::vector<std::thread> threads;
+            threads.reserve(thread_count - 1);
+            auto join_threads = [&threads]()
+            {
+                for (auto& thread : threads)
+                {
+                    thread.join();
+                }
+            };
+            try
+            {
+                for (size_t thread_index = 1; thread_index < thread_count; ++thread_index)
+                {
+                    threads.emplace_back(worker);
+                }
+            }
+            catch (...)
+            {
+                //the started workers stop after their current task, a joinable thread must not be destroyed
+                failed = true;
+                join_threads();
+                throw;
+            }
+            //the calling thread takes part in the work
+            worker();
+            join_threads();
+        }
+
+        for (const auto& error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    /**
+     * Calls @p task for every index within @p waves, one wave after another.
+     * The indices of a wave are handed to up to @p worker_count threads (see @ref parallelFor),
+     * the next wave starts once all tasks of the previous one have returned.
+     * If a task throws, the remaining waves are not started.
+     *
+     * @param [in] waves the indices of the work items, grouped by wave
+     * @param [in] worker_count maximum number of concurrent tasks within a wave
+     * @param [in] task the work item callback, called with the index of the item
+     * @param [in] worker_pool the pool to run the workers on, nullptr to start threads for every wave
+     */
+    inline void parallelForWaves(const std::vector<std::vector<size_t>>& waves,
+                                 size_t worker_count,
+                                 const std::function<void(size_t)>& task,
+                                 WorkerPool* worker_pool = nullptr)
+    {
+        for (const auto& wave : waves)
+        {
+            parallelFor(wave.size(), worker_count, [&](size_t position)
+            {
+                task(wave[position]);
+            }, worker_pool);
+        }
+    }
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,255 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "parse_cache.h"
+
+#include <a_util/filesystem.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    std::string getCanonicalPath(const std::string& file_path)
+    {
+        a_util::filesystem::Path canonical_path = file_path;
+        if (canonical_path.isRelative())
+        {
+            a_util::filesystem::Path working_path = a_util::filesystem::getWorkingDirectory();
+            working_path.append(canonical_path);
+            canonical_path = working_path;
+        }
+        canonical_path.makeCanonical();
+        return canonical_path;
+    }
+
+    bool getFileStamp(const std::string& file_path, FileStamp& file_stamp)
+    {
+#ifdef WIN32
+        struct _stat64 file_status;
+        if (_stat64(file_path.c_str(), &file_status) != 0)
+        {
+            return false;
+        }
+        file_stamp._size = static_cast<int64_t>(file_status.st_size);
+        file_stamp._modification_time_ns = static_cast<int64_t>(file_status.st_mtime) * 1000000000;
+#else
+        struct stat file_status;
+        if (::stat(file_path.c_str(), &file_status) != 0)
+        {
+            return false;
+        }
+        file_stamp._size = static_cast<int64_t>(file_status.st_size);
+        file_stamp._modification_time_ns = static_cast<int64_t>(file_status.st_mtim.tv_sec) * 1000000000
+            + static_cast<int64_t>(file_status.st_mtim.tv_nsec);
+#endif
+        return true;
+    }
+
+    ParseCache& ParseCache::getInstance()
+    {
+        static ParseCache parse_cache;
+        return parse_cache;
+    }
+
+    ParseCache::Entry* ParseCache::findEntry(const std::string& canonical_path, const FileStamp& file_stamp)
+    {
+        auto found = _entries.find(canonical_path);
+        if (found == _entries.end())
+        {
+            return nullptr;
+        }
+        if (!(found->second._file_stamp == file_stamp))
+        {
+            //the file changed on disk
+            eraseEntry(found);
+            return nullptr;
+        }
+        _lru.splice(_lru.begin(), _lru, found->second._lru_position);
+        return &found->second;
+    }
+
+    std::shared_ptr<const SystemDescription> ParseCache::findSystemDescription(const std::string& canonical_path,
+                                                                               const FileStamp& file_stamp)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto entry = findEntry(canonical_path, file_stamp);
+        if (entry && entry->_system_description)
+        {
+            ++_hits;
+            return entry->_system_description;
+        }
+        ++_misses;
+        return {};
+    }
+
+    std::shared_ptr<const PropertyTable> ParseCache::findPropertyTable(const std::string& canonical_path,
+                                                                       const FileStamp& file_stamp)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto entry = findEntry(canonical_path, file_stamp);
+        if (entry && entry->_property_table)
+        {
+            ++_hits;
+            return entry->_property_table;
+        }
+        ++_misses;
+        return {};
+    }
+
+    ParseCache::Entry& ParseCache::prepareEntry(const std::string& canonical_path, const FileStamp& file_stamp)
+    {
+        auto found = _entries.find(canonical_path);
+        if (found != _entries.end() && !(found->second._file_stamp == file_stamp))
+        {
+            eraseEntry(found);
+            found = _entries.end();
+        }
+        if (found == _entries.end())
+        {
+            _lru.push_front(canonical_path);
+            auto& entry = _entries[canonical_path];
+            entry._file_stamp = file_stamp;
+            entry._lru_position = _lru.begin();
+            return entry;
+        }
+        _lru.splice(_lru.begin(), _lru, found->second._lru_position);
+        return found->second;
+    }
+
+    void ParseCache::store(const std::string& canonical_path,
+                           const FileStamp& file_stamp,
+                           std::shared_ptr<const SystemDescription> system_description)
+    {
+        const size_t memory_usage = estimateMemoryUsage(*system_description);
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (memory_usage > _memory_limit)
+        {
+            return;
+        }
+        auto& entry = prepareEntry(canonical_path, file_stamp);
+        if (entry._system_description)
+        {
+            _memory_usage -= estimateMemoryUsage(*entry._system_description);
+            entry._memory_usage -= estimateMemoryUsage(*entry._system_description);
+        }
+        entry._system_description = std::move(system_description);
+        entry._memory_usage += memory_usage;
+        _memory_usage += memory_usage;
+        shrinkToLimit();
+    }
+
+    void ParseCache::store(const std::string& canonical_path,
+                           const FileStamp& file_stamp,
+                           std::shared_ptr<const PropertyTable> property_table)
+    {
+        const size_t memory_usage = estimateMemoryUsage(*property_table);
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (memory_usage > _memory_limit)
+        {
+            return;
+        }
+        auto& entry = prepareEntry(canonical_path, file_stamp);
+        if (entry._property_table)
+        {
+            _memory_usage -= estimateMemoryUsage(*entry._property_table);
+            entry._memory_usage -= estimateMemoryUsage(*entry._property_table);
+        }
+        entry._property_table = std::move(property_table);
+        entry._memory_usage += memory_usage;
+        _memory_usage += memory_usage;
+        shrinkToLimit();
+    }
+
+    void ParseCache::eraseEntry(std::unordered_map<std::string, Entry>::iterator entry)
+    {
+        _memory_usage -= entry->second._memory_usage;
+        _lru.erase(entry->second._lru_position);
+        _entries.erase(entry);
+    }
+
+    void ParseCache::shrinkToLimit()
+    {
+        while (_memory_usage > _memory_limit && !_lru.empty())
+        {
+            eraseEntry(_entries.find(_lru.back()));
+        }
+    }
+
+    void ParseCache::invalidate()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+        _lru.clear();
+        _memory_usage = 0;
+    }
+
+    void ParseCache::invalidate(const std::string& canonical_path)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _entries.find(canonical_path);
+        if (found != _entries.end())
+        {
+            eraseEntry(found);
+        }
+    }
+
+    void ParseCache::setMemoryLimit(size_t memory_limit)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _memory_limit = memory_limit;
+        shrinkToLimit();
+    }
+
+    DescriptionCacheStatistics ParseCache::getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        DescriptionCacheStatistics statistics;
+        statistics._entries = _entries.size();
+        statistics._memory_usage = _memory_usage;
+        statistics._memory_limit = _memory_limit;
+        statistics._hits = _hits;
+        statistics._misses = _misses;
+        return statistics;
+    }
+} // namespace detail
+
+void setDescriptionCacheLimit(size_t memory_limit)
+{
+    detail::ParseCache::getInstance().setMemoryLimit(memory_limit);
+}
+
+void invalidateDescriptionCache()
+{
+    detail::ParseCache::getInstance().invalidate();
+}
+
+void invalidateDescriptionCache(const std::string& file_path)
+{
+    detail::ParseCache::getInstance().invalidate(detail::getCanonicalPath(file_path));
+}
+
+DescriptionCacheStatistics getDescriptionCacheStatistics()
+{
+    return detail::ParseCache::getInstance().getStatistics();
+}
+} // namespace controller
+} // namespace fep3
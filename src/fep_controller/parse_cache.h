@@ -0,0 +1,119 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/description_cache.h>
+
+#include "property_table.h"
+#include "system_description.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * Identifies the state of a file on disk
+     */
+    struct FileStamp
+    {
+        int64_t _size = 0;
+        int64_t _modification_time_ns = 0;
+
+        bool operator==(const FileStamp& other) const
+        {
+            return _size == other._size && _modification_time_ns == other._modification_time_ns;
+        }
+    };
+
+    /**
+     * @return the absolute canonical path of @p file_path
+     */
+    std::string getCanonicalPath(const std::string& file_path);
+
+    /**
+     * Retrieves size and modification time of the file @p file_path
+     *
+     * @return false if the file can not be accessed
+     */
+    bool getFileStamp(const std::string& file_path, FileStamp& file_stamp);
+
+    /**
+     * Process wide cache of parsed system and property descriptions, keyed by canonical path.
+     * Entries are only returned as long as the file stamp did not change,
+     * the least recently used entries are dropped if the memory limit is exceeded.
+     */
+    class ParseCache
+    {
+    public:
+        static ParseCache& getInstance();
+
+        std::shared_ptr<const SystemDescription> findSystemDescription(const std::string& canonical_path,
+                                                                       const FileStamp& file_stamp);
+        std::shared_ptr<const PropertyTable> findPropertyTable(const std::string& canonical_path,
+                                                               const FileStamp& file_stamp);
+        void store(const std::string& canonical_path,
+                   const FileStamp& file_stamp,
+                   std::shared_ptr<const SystemDescription> system_description);
+        void store(const std::string& canonical_path,
+                   const FileStamp& file_stamp,
+                   std::shared_ptr<const PropertyTable> property_table);
+
+        void invalidate();
+        void invalidate(const std::string& canonical_path);
+        void setMemoryLimit(size_t memory_limit);
+        DescriptionCacheStatistics getStatistics() const;
+
+    private:
+        ParseCache() = default;
+
+        struct Entry
+        {
+            FileStamp _file_stamp;
+            std::shared_ptr<const SystemDescription> _system_description;
+            std::shared_ptr<const PropertyTable> _property_table;
+            size_t _memory_usage = 0;
+            std::list<std::string>::iterator _lru_position;
+        };
+
+        Entry* findEntry(const std::string& canonical_path, const FileStamp& file_stamp);
+        Entry& prepareEntry(const std::string& canonical_path, const FileStamp& file_stamp);
+        void eraseEntry(std::unordered_map<std::string, Entry>::iterator entry);
+        void shrinkToLimit();
+
+    private:
+        mutable std::mutex _mutex;
+        std::unordered_map<std::string, Entry> _entries;
+        /// most recently used first
+        std::list<std::string> _lru;
+        size_t _memory_usage = 0;
+        size_t _memory_limit = description_cache_default_memory_limit;
+        uint64_t _hits = 0;
+        uint64_t _misses = 0;
+    };
+} // namespace detail
+} // namespace controller
+} // namespace fep3
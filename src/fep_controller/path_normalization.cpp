@@ -0,0 +1,62 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "path_normalization.h"
+
+#include <a_util/strings.h>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    a_util::filesystem::Path normalizeToAnotherPath(const a_util::filesystem::Path& file_reference,
+                                                    const a_util::filesystem::Path& other_file_path)
+    {
+        a_util::filesystem::Path file_path_normalized = file_reference;
+        
+        if (!file_path_normalized.isEmpty())
+        {
+            std::string file_path_normalized_as_string = file_path_normalized;
+            a_util::strings::trim(file_path_normalized_as_string);
+            file_path_normalized = file_path_normalized_as_string;
+            if (file_path_normalized_as_string[0] == '$' && file_path_normalized_as_string[1] == '(')
+            {
+                //this might be a macro at the beginning !! do not change it 
+                //this macro support is for further use!
+                return file_path_normalized;
+            }
+            else
+            {
+                if (file_reference.isRelative())
+                {
+                    file_path_normalized = other_file_path;
+                    file_path_normalized.append(file_reference);
+                }
+                file_path_normalized.makeCanonical();
+                return file_path_normalized;
+            }
+        }
+        else
+        {
+            return file_reference;
+        }
+    }
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,37 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <a_util/filesystem.h>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * Makes the @p file_reference found within a description file relative to @p other_file_path
+     * (usually the directory of the description file) and canonical.
+     * Empty references and references starting with a macro "$(" are returned unchanged (apart from trimming).
+     */
+    a_util::filesystem::Path normalizeToAnotherPath(const a_util::filesystem::Path& file_reference,
+                                                    const a_util::filesystem::Path& other_file_path);
+} // namespace detail
+} // namespace controller
+} // namespace fep3
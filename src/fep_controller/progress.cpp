@@ -0,0 +1,35 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "fep_controller/deadlines.h"
+#include "fep_controller/progress.h"
+
+namespace fep3
+{
+namespace controller
+{
+    OperationCancelledError::OperationCancelledError(const std::string& what)
+        : std::runtime_error(what)
+    {
+    }
+
+    DeadlineExceededError::DeadlineExceededError(const std::string& what)
+        : std::runtime_error(what)
+    {
+    }
+} // namespace controller
+} // namespace fep3
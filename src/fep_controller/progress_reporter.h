@@ -0,0 +1,71 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/progress.h>
+
+#include <mutex>
+#include <string>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * Serializes the calls of a progress callback and checks the cancellation token
+     */
+    class ProgressReporter
+    {
+    public:
+        ProgressReporter(const ProgressCallback& progress_callback,
+                         const CancellationToken& cancellation_token)
+            : _progress_callback(progress_callback),
+              _cancellation_token(cancellation_token)
+        {
+        }
+
+        void report(ProgressStage stage, const std::string& participant_name)
+        {
+            if (_progress_callback)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _progress_callback(stage, participant_name);
+            }
+        }
+
+        /**
+         * @throws OperationCancelledError if the cancellation was requested
+         */
+        void throwIfCancelled(const std::string& system_name) const
+        {
+            if (_cancellation_token.isCancelled())
+            {
+                throw OperationCancelledError("the operation on system " + system_name + " was cancelled");
+            }
+        }
+
+    private:
+        const ProgressCallback& _progress_callback;
+        CancellationToken _cancellation_token;
+        std::mutex _mutex;
+    };
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,159 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "fep_controller/properties_watcher.h"
+
+#include "applied_properties_data.h"
+#include "description_loader.h"
+#include "fep_system_access.h"
+#include "file_watch.h"
+#include "trace_scope.h"
+
+#include <atomic>
+#include <thread>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    struct PropertiesWatcherData
+    {
+        std::unique_ptr<FepSystemAccess> _fep_system_access;
+        ISystemAccess* _system = nullptr;
+        std::string _system_properties_file;
+        WatchOptions _options;
+        //the baseline if no applied properties are given
+        AppliedProperties _applied_properties;
+        std::unique_ptr<FileWatch> _file_watch;
+        std::atomic<uint64_t> _reload_count{ 0 };
+        std::thread _thread;
+    };
+
+    namespace
+    {
+        void reload(PropertiesWatcherData& data)
+        {
+            std::string error_message;
+            try
+            {
+                TraceScope trace("reloadSystemProperties", std::string(), data._system_properties_file);
+                configureSystemProperties(*data._system, data._system_properties_file, data._options._configure_options);
+            }
+            catch (const std::exception& err)
+            {
+                error_message = err.what();
+            }
+            ++data._reload_count;
+            if (data._options._reload_callback)
+            {
+                data._options._reload_callback(error_message);
+            }
+        }
+
+        void watch(PropertiesWatcherData& data)
+        {
+            try
+            {
+                while (data._file_watch->waitForChange())
+                {
+                    reload(data);
+                }
+            }
+            catch (const std::exception& err)
+            {
+                //the watch ends, but the failure is not lost
+                if (data._options._reload_callback)
+                {
+                    data._options._reload_callback(err.what());
+                }
+            }
+        }
+
+        void startWatch(PropertiesWatcherData& data)
+        {
+            //watch before the baseline is read, a save in between is not missed
+            data._file_watch.reset(new FileWatch(data._system_properties_file,
+                                                 data._options._debounce,
+                                                 data._options._poll_interval));
+            auto& configure_options = data._options._configure_options;
+            configure_options._retry_report = nullptr;
+            configure_options._dry_run = false;
+            if (!configure_options._applied_properties)
+            {
+                const auto property_table = loadPropertyTable(data._system_properties_file,
+                                                              configure_options._streaming_parse_threshold);
+                std::vector<std::string> participant_names;
+                for (const auto& participant : data._system->getParticipants())
+                {
+                    participant_names.push_back(participant->getName());
+                }
+                recordAppliedTable(AppliedPropertiesAccess::get(data._applied_properties),
+                                   data._system->getSystemName(),
+                                   participant_names,
+                                   *property_table);
+                configure_options._applied_properties = &data._applied_properties;
+            }
+            data._thread = std::thread(watch, std::ref(data));
+        }
+    }
+} // namespace detail
+
+PropertiesWatcher::PropertiesWatcher(fep3::System& system,
+                                     const std::string& system_properties_file,
+                                     const WatchOptions& options)
+    : _data(new detail::PropertiesWatcherData())
+{
+    _data->_fep_system_access.reset(new detail::FepSystemAccess(system, options._configure_options._batch_writer_factory));
+    _data->_system = _data->_fep_system_access.get();
+    _data->_system_properties_file = system_properties_file;
+    _data->_options = options;
+    detail::startWatch(*_data);
+}
+
+PropertiesWatcher::PropertiesWatcher(ISystemAccess& system,
+                                     const std::string& system_properties_file,
+                                     const WatchOptions& options)
+    : _data(new detail::PropertiesWatcherData())
+{
+    _data->_system = &system;
+    _data->_system_properties_file = system_properties_file;
+    _data->_options = options;
+    detail::startWatch(*_data);
+}
+
+PropertiesWatcher::~PropertiesWatcher()
+{
+    stop();
+}
+
+void PropertiesWatcher::stop()
+{
+    if (_data->_thread.joinable())
+    {
+        _data->_file_watch->stop();
+        _data->_thread.join();
+    }
+}
+
+uint64_t PropertiesWatcher::getReloadCount() const
+{
+    return _data->_reload_count;
+}
+} // namespace controller
+} // namespace fep3
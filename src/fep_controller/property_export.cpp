@@ -0,0 +1,526 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "fep_controller/property_export.h"
+#include "fep_controller/snapshot.h"
+#include <a_util/strings.h>
+
+#include "configuration_node.h"
+#include "fep_system_access.h"
+#include "parallel_for.h"
+#include "property_table.h"
+#include "request_runner.h"
+#include "snapshot_format.h"
+#include "trace_scope.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    namespace
+    {
+        /// type the participants report for a node holding further properties
+        const char property_node_type[] = "node";
+
+        using Properties = std::vector<PropertyAssignment>;
+
+        /**
+         * What was read from one participant
+         */
+        struct ParticipantProperties
+        {
+            /// false if the participant could not be read completely, it is left out then
+            bool _read = false;
+            Properties _system_properties;
+            Properties _element_properties;
+            std::vector<ConfigurationFailure> _failures;
+        };
+
+        std::string joinNodePath(const std::string& node_path, const std::string& name)
+        {
+            return node_path == "/" ? "/" + name : node_path + "/" + name;
+        }
+
+        /// @return true if @p name (relative to "/") lies within "/system"
+        bool isWithinSystemNode(const std::string& name)
+        {
+            return name == "system" || name.compare(0, 7, "system/") == 0;
+        }
+
+        /**
+         * Appends the properties of @p node_path to @p properties, walking into the child nodes.
+         * The names are relative to the node the walk started at (@p name_prefix is the path to @p node_path).
+         */
+        void readNode(const std::shared_ptr<IParticipantAccess>& participant,
+                      const std::string& node_path,
+                      const std::string& name_prefix,
+                      bool skip_system_node,
+                      RequestRunner& requests,
+                      Properties& properties)
+        {
+            const auto node = std::make_shared<ConfigurationNode>(participant, node_path);
+            requests.run("getProperties", [node]()
+            {
+                node->fetch();
+                return true;
+            });
+            const auto names = requests.run("getPropertyNames", [node]()
+            {
+                return node->call([](fep3::IProperties& properties_node) { return properties_node.getPropertyNames(); });
+            });
+            for (const auto& name : names)
+            {
+                if (skip_system_node && isWithinSystemNode(name))
+                {
+                    continue;
+                }
+                auto type = requests.run("getPropertyType", [node, name]()
+                {
+                    return node->call([&](fep3::IProperties& properties_node) { return properties_node.getPropertyType(name); });
+                });
+                if (type == property_node_type)
+                {
+                    readNode(participant, joinNodePath(node_path, name), name_prefix + name + "/",
+                             false, requests, properties);
+                    continue;
+                }
+                auto value = requests.run("getProperty", [node, name]()
+                {
+                    return node->call([&](fep3::IProperties& properties_node) { return properties_node.getProperty(name); });
+                });
+                properties.push_back({ name_prefix + name, std::move(type), std::move(value) });
+            }
+        }
+
+        /**
+         * Reads "/system" and "/" of @p participant.
+         * Failures are recorded within the result if @p collect_failures is set, thrown otherwise.
+         */
+        ParticipantProperties readParticipant(const std::shared_ptr<IParticipantAccess>& participant,
+                                              const std::string& participant_name,
+                                              const ExportOptions& options,
+                                              const OperationDeadline& operation_deadline,
+                                              bool collect_failures)
+        {
+            TraceScope trace("exportParticipant", participant_name);
+            ParticipantProperties read;
+            RequestRunner requests(participant_name, options._deadlines, options._retry, operation_deadline);
+            std::string node_path = "/system";
+            try
+            {
+                const auto configuration = requests.run("getConfiguration", [participant]() { return participant->getConfiguration(); });
+                if (!configuration)
+                {
+                    throw std::runtime_error("the configuration service can not be reached");
+                }
+                readNode(participant, node_path, std::string(), false, requests, read._system_properties);
+                node_path = "/";
+                readNode(participant, node_path, std::string(), true, requests, read._element_properties);
+                read._read = true;
+            }
+            catch (const std::runtime_error& err)
+            {
+                const auto message = a_util::strings::format("Unable to read properties '%s' of participant '%s': %s",
+                    node_path.c_str(),
+                    participant_name.c_str(),
+                    err.what());
+                if (!collect_failures)
+                {
+                    if (dynamic_cast<const DeadlineExceededError*>(&err))
+                    {
+                        throw DeadlineExceededError(message);
+                    }
+                    throw std::runtime_error(message);
+                }
+                ConfigurationFailure failure;
+                failure._step = ConfigurationStep::property;
+                failure._participant_name = participant_name;
+                failure._node_path = node_path;
+                failure._reason = message;
+                read._failures.push_back(std::move(failure));
+                read._system_properties.clear();
+                read._element_properties.clear();
+            }
+            return read;
+        }
+
+        /**
+         * Receives the sections of a system properties file, the system properties first
+         */
+        class PropertyFileWriter
+        {
+        public:
+            virtual ~PropertyFileWriter() = default;
+            virtual void writeSystemProperties(const Properties& properties) = 0;
+            virtual void writeElementInstance(const std::string& element_id, const Properties& properties) = 0;
+            virtual void finish() = 0;
+        };
+
+        /**
+         * Writes an xml system properties file section by section
+         */
+        class XmlPropertyFileWriter : public PropertyFileWriter
+        {
+        public:
+            explicit XmlPropertyFileWriter(const std::string& file_path)
+                : _file_path(file_path),
+                  _stream(file_path, std::ios::out | std::ios::binary | std::ios::trunc)
+            {
+                throwIfFailed();
+                _stream << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+                        << "<property_file xmlns=\"http://fep.vwgroup.com/system/2.0/properties\">\n"
+                        << "    <schema_version>2.0.0</schema_version>\n"
+                        << "    <system_timing_properties>\n"
+                        << "    </system_timing_properties>\n";
+            }
+
+            void writeSystemProperties(const Properties& properties) override
+            {
+                _stream << "    <system_properties>\n";
+                writeProperties(properties, "        ");
+                _stream << "    </system_properties>\n"
+                        << "    <element_instances_properties>\n";
+                throwIfFailed();
+            }
+
+            void writeElementInstance(const std::string& element_id, const Properties& properties) override
+            {
+                _stream << "        <element_instance>\n"
+                        << "            <id>" << escape(element_id) << "</id>\n"
+                        << "            <properties>\n";
+                writeProperties(properties, "                ");
+                _stream << "            </properties>\n"
+                        << "        </element_instance>\n";
+                throwIfFailed();
+            }
+
+            void finish() override
+            {
+                _stream << "    </element_instances_properties>\n"
+                        << "</property_file>\n";
+                _stream.close();
+                throwIfFailed();
+            }
+
+        private:
+            static std::string escape(const std::string& text)
+            {
+                std::string escaped;
+                escaped.reserve(text.size());
+                for (const char character : text)
+                {
+                    switch (character)
+                    {
+                    case '&': escaped.append("&amp;"); break;
+                    case '<': escaped.append("&lt;"); break;
+                    case '>': escaped.append("&gt;"); break;
+                    default: escaped.push_back(character); break;
+                    }
+                }
+                return escaped;
+            }
+
+            void writeProperties(const Properties& properties, const char* indent)
+            {
+                for (const auto& property : properties)
+                {
+                    _stream << indent << "<property>\n"
+                            << indent << "    <name>" << escape(property._name) << "</name>\n"
+                            << indent << "    <type>" << escape(property._type) << "</type>\n"
+                            << indent << "    <value>" << escape(property._value) << "</value>\n"
+                            << indent << "</property>\n";
+                }
+            }
+
+            void throwIfFailed()
+            {
+                if (!_stream)
+                {
+                    throw std::runtime_error(a_util::strings::format("the system properties file '%s' can not be written",
+                        _file_path.c_str()));
+                }
+            }
+
+        private:
+            const std::string _file_path;
+            std::ofstream _stream;
+        };
+
+        /**
+         * Collects the sections into a property table and writes it as snapshot
+         */
+        class SnapshotPropertyFileWriter : public PropertyFileWriter
+        {
+        public:
+            explicit SnapshotPropertyFileWriter(const std::string& file_path)
+                : _file_path(file_path)
+            {
+            }
+
+            void writeSystemProperties(const Properties& properties) override
+            {
+                _system_properties = addPropertyList(properties);
+            }
+
+            void writeElementInstance(const std::string& element_id, const Properties& properties) override
+            {
+                _element_instances.push_back({ element_id, addPropertyList(properties) });
+            }
+
+            void finish() override
+            {
+                writeSnapshot(PropertyTable(_columns.finishList(),
+                                            std::move(_system_properties),
+                                            std::move(_element_instances)),
+                              _file_path);
+            }
+
+        private:
+            PropertyList addPropertyList(const Properties& properties)
+            {
+                for (const auto& property : properties)
+                {
+                    _columns.add(property._name, property._type, property._value);
+                }
+                return _columns.finishList();
+            }
+
+        private:
+            const std::string _file_path;
+            PropertyListBuilder _columns;
+            PropertyList _system_properties;
+            std::vector<PropertyTable::ElementInstance> _element_instances;
+        };
+
+        /**
+         * @return a name next to @p target_file which is not used by another export of this or another process
+         *         and by no existing file
+         */
+        std::string makeTemporaryFileName(const std::string& target_file)
+        {
+            static std::atomic<uint64_t> export_counter{ 0 };
+#ifdef WIN32
+            const auto process_id = static_cast<uint64_t>(GetCurrentProcessId());
+#else
+            const auto process_id = static_cast<uint64_t>(getpid());
+#endif
+            for (;;)
+            {
+                const auto temporary_file = a_util::strings::format("%s.%llu.%llu.tmp",
+                    target_file.c_str(),
+                    static_cast<unsigned long long>(process_id),
+                    static_cast<unsigned long long>(export_counter++));
+                if (!std::ifstream(temporary_file).is_open())
+                {
+                    return temporary_file;
+                }
+            }
+        }
+
+        /**
+         * Moves @p source_file over @p target_file, replacing an existing target
+         * @return whether the file was moved
+         */
+        bool replaceFile(const std::string& source_file, const std::string& target_file)
+        {
+#ifdef WIN32
+            return MoveFileExA(source_file.c_str(), target_file.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+            return std::rename(source_file.c_str(), target_file.c_str()) == 0;
+#endif
+        }
+
+        /**
+         * Passes the participants to a writer in the order of the system, as soon as a participant
+         * and all before it are read. Called by the workers, one at a time.
+         */
+        class OrderedExport
+        {
+        public:
+            OrderedExport(PropertyFileWriter& writer, const std::vector<std::string>& participant_names)
+                : _writer(writer),
+                  _participant_names(participant_names),
+                  _pending(participant_names.size())
+            {
+            }
+
+            void add(size_t index, ParticipantProperties read)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _pending[index].reset(new ParticipantProperties(std::move(read)));
+                for (; _next < _pending.size() && _pending[_next]; ++_next)
+                {
+                    write(_participant_names[_next], *_pending[_next]);
+                    //the properties are not needed any longer
+                    _pending[_next].reset(new ParticipantProperties());
+                }
+            }
+
+            void finish()
+            {
+                if (!_has_system_properties)
+                {
+                    _writer.writeSystemProperties(Properties());
+                }
+                _writer.finish();
+            }
+
+            /// @return the failures of all participants in the order of the system
+            const std::vector<ConfigurationFailure>& getFailures() const
+            {
+                return _failures;
+            }
+
+        private:
+            void write(const std::string& participant_name, ParticipantProperties& read)
+            {
+                _failures.insert(_failures.end(), read._failures.begin(), read._failures.end());
+                if (!read._read)
+                {
+                    return;
+                }
+                if (!_has_system_properties)
+                {
+                    _writer.writeSystemProperties(read._system_properties);
+                    for (const auto& property : read._system_properties)
+                    {
+                        //the first property with a name wins, as within the property file
+                        _system_properties.emplace(property._name, std::make_pair(property._type, property._value));
+                    }
+                    _has_system_properties = true;
+                }
+                else
+                {
+                    //"/system" of this participant differs: set it through "/" like any other property
+                    for (const auto& property : read._system_properties)
+                    {
+                        auto found = _system_properties.find(property._name);
+                        if (found == _system_properties.end()
+                            || found->second.first != property._type
+                            || found->second.second != property._value)
+                        {
+                            read._element_properties.push_back({ "system/" + property._name,
+                                                                 property._type,
+                                                                 property._value });
+                        }
+                    }
+                }
+                _writer.writeElementInstance(participant_name, read._element_properties);
+            }
+
+        private:
+            PropertyFileWriter& _writer;
+            const std::vector<std::string>& _participant_names;
+            std::mutex _mutex;
+            std::vector<std::unique_ptr<ParticipantProperties>> _pending;
+            size_t _next = 0;
+            bool _has_system_properties = false;
+            std::map<std::string, std::pair<std::string, std::string>> _system_properties;
+            std::vector<ConfigurationFailure> _failures;
+        };
+    }
+} // namespace detail
+
+void exportSystemProperties(fep3::System& system,
+                            const std::string& system_properties_file,
+                            const ExportOptions& options)
+{
+    detail::FepSystemAccess system_access(system, PropertyBatchWriterFactory());
+    exportSystemProperties(system_access, system_properties_file, options);
+}
+
+void exportSystemProperties(ISystemAccess& system,
+                            const std::string& system_properties_file,
+                            const ExportOptions& options)
+{
+    detail::TraceScope trace("exportSystemProperties", std::string(), system_properties_file);
+    const detail::OperationDeadline operation_deadline(options._deadlines._operation_deadline);
+    const auto system_name = system.getSystemName();
+    if (options._report)
+    {
+        *options._report = ConfigurationReport();
+        options._report->_system_name = system_name;
+    }
+
+    const auto participants = system.getParticipants();
+    std::vector<std::string> participant_names;
+    participant_names.reserve(participants.size());
+    for (const auto& participant : participants)
+    {
+        participant_names.push_back(participant->getName());
+    }
+
+    //the file is written next to the target and replaces it only once it is complete
+    const std::string temporary_file = detail::makeTemporaryFileName(system_properties_file);
+    std::unique_ptr<detail::PropertyFileWriter> writer;
+    if (detail::isSnapshotFile(system_properties_file))
+    {
+        writer.reset(new detail::SnapshotPropertyFileWriter(temporary_file));
+    }
+    else
+    {
+        writer.reset(new detail::XmlPropertyFileWriter(temporary_file));
+    }
+    detail::OrderedExport ordered_export(*writer, participant_names);
+    try
+    {
+        detail::parallelFor(participants.size(), options._worker_count, [&](size_t index)
+        {
+            if (options._cancellation_token.isCancelled())
+            {
+                throw OperationCancelledError("the operation on system " + system_name + " was cancelled");
+            }
+            ordered_export.add(index, detail::readParticipant(participants[index], participant_names[index], options,
+                                                              operation_deadline, options._report != nullptr));
+        });
+        ordered_export.finish();
+        writer.reset();
+        if (!detail::replaceFile(temporary_file, system_properties_file))
+        {
+            throw std::runtime_error(a_util::strings::format("the system properties file '%s' can not be replaced",
+                system_properties_file.c_str()));
+        }
+    }
+    catch (...)
+    {
+        //no incomplete file is left behind, an existing file is kept as it was
+        writer.reset();
+        std::remove(temporary_file.c_str());
+        throw;
+    }
+    if (options._report)
+    {
+        options._report->_failures = ordered_export.getFailures();
+    }
+}
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,149 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "fep_controller/property_overlay.h"
+#include <a_util/strings.h>
+
+#include "controller_steps.h"
+#include "description_loader.h"
+#include "fep_system_access.h"
+#include "trace_scope.h"
+
+#include <unordered_map>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    namespace
+    {
+        PropertyList mergeProperties(const PropertyList& properties,
+                                     const std::string& element_id,
+                                     const std::vector<const PropertyOverride*>& overrides)
+        {
+            std::vector<PropertyAssignment> merged = properties.getProperties();
+            //the properties added by the overlay, a later override replaces them as well
+            std::unordered_map<std::string, size_t> added;
+            for (const auto property_override : overrides)
+            {
+                PropertyAssignment* merged_property = nullptr;
+                size_t found = 0;
+                if (properties.find(property_override->_name, found))
+                {
+                    merged_property = &merged[found];
+                }
+                else
+                {
+                    auto found_added = added.find(property_override->_name);
+                    if (found_added != added.end())
+                    {
+                        merged_property = &merged[found_added->second];
+                    }
+                }
+
+                if (merged_property)
+                {
+                    merged_property->_value = property_override->_value;
+                    if (!property_override->_type.empty())
+                    {
+                        merged_property->_type = property_override->_type;
+                    }
+                }
+                else if (property_override->_type.empty())
+                {
+                    throw std::runtime_error(a_util::strings::format(
+                        "the property '%s' of '%s' is not within the base properties and its override has no type",
+                        property_override->_name.c_str(),
+                        element_id.empty() ? "system" : element_id.c_str()));
+                }
+                else
+                {
+                    added.emplace(property_override->_name, merged.size());
+                    merged.push_back({ property_override->_name, property_override->_type, property_override->_value });
+                }
+            }
+            return PropertyList(merged);
+        }
+    }
+
+    PropertyTable mergeOverlay(const PropertyTable& base, const PropertyOverlay& overlay)
+    {
+        //the overrides grouped by element id, the ones of the system properties by the empty id
+        std::unordered_map<std::string, std::vector<const PropertyOverride*>> overrides;
+        std::vector<std::string> added_element_ids;
+        for (const auto& property_override : overlay._overrides)
+        {
+            auto& element_overrides = overrides[property_override._element_id];
+            if (element_overrides.empty()
+                && !property_override._element_id.empty()
+                && !base.findElementProperties(property_override._element_id))
+            {
+                added_element_ids.push_back(property_override._element_id);
+            }
+            element_overrides.push_back(&property_override);
+        }
+        auto merge = [&overrides](const PropertyList& properties, const std::string& element_id)
+        {
+            auto found = overrides.find(element_id);
+            return found != overrides.end()
+                ? mergeProperties(properties, element_id, found->second)
+                : properties;
+        };
+
+        std::vector<PropertyTable::ElementInstance> element_instances;
+        element_instances.reserve(base.getElementInstances().size() + added_element_ids.size());
+        for (const auto& element_instance : base.getElementInstances())
+        {
+            element_instances.push_back({ element_instance._id, merge(element_instance._properties, element_instance._id) });
+        }
+        for (const auto& element_id : added_element_ids)
+        {
+            element_instances.push_back({ element_id, merge(PropertyList(), element_id) });
+        }
+        return PropertyTable(base.getSystemTimingProperties(),
+                             merge(base.getSystemProperties(), std::string()),
+                             std::move(element_instances));
+    }
+} // namespace detail
+
+void applyPropertyOverlay(fep3::System& system,
+                          const std::string& base_properties_file,
+                          const PropertyOverlay& overlay,
+                          const ConfigureOptions& options)
+{
+    detail::FepSystemAccess system_access(system, options._batch_writer_factory);
+    applyPropertyOverlay(system_access, base_properties_file, overlay, options);
+}
+
+void applyPropertyOverlay(ISystemAccess& system,
+                          const std::string& base_properties_file,
+                          const PropertyOverlay& overlay,
+                          const ConfigureOptions& options)
+{
+    detail::TraceScope trace("applyPropertyOverlay", std::string(), base_properties_file);
+    const detail::OperationDeadline operation_deadline(options._deadlines._operation_deadline);
+    //the base is kept by the description cache, an unchanged file is not parsed again
+    const auto base = detail::loadPropertyTable(base_properties_file, options._streaming_parse_threshold);
+    const auto property_table = detail::mergeOverlay(*base, overlay);
+    detail::ProgressReporter progress(options._progress_callback, options._cancellation_token);
+    progress.report(ProgressStage::parsed, std::string());
+    detail::configureSystemProperties(system, property_table, options, progress, operation_deadline);
+}
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,338 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "description_loader.h"
+#include "trace_scope.h"
+#include "xml_stream_reader.h"
+
+#include <a_util/strings.h>
+
+#include <fstream>
+#include <stdexcept>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    namespace
+    {
+        std::string getLocalName(const std::string& name)
+        {
+            const auto prefix_end = name.find(':');
+            return prefix_end == std::string::npos ? name : name.substr(prefix_end + 1);
+        }
+
+        /**
+         * Builds the property table from the events of the properties file.
+         * The checks of the data model are the ones of fep::metamodel::PropertyFile,
+         * the first data model error is kept, but the stream is read to the end, so
+         * xml errors are reported in favour of data model errors (like the DOM based loader does).
+         */
+        class PropertyFileStreamHandler : public IXmlStreamHandler
+        {
+        private:
+            enum class Section
+            {
+                none,
+                system_timing_properties,
+                system_properties,
+                element_instances_properties
+            };
+
+            struct PropertyState
+            {
+                bool _active = false;
+                size_t _depth = 0;
+                bool _has_name = false;
+                bool _has_type = false;
+                bool _has_value = false;
+                PropertyAssignment _property;
+            };
+
+            struct ElementInstanceState
+            {
+                bool _active = false;
+                bool _has_id = false;
+                bool _has_properties = false;
+                std::string _id;
+            };
+
+        public:
+            void onStartElement(const std::string& name) override
+            {
+                const std::string local_name = getLocalName(name);
+                const size_t depth = _path.size();
+                _path.push_back(local_name);
+                _text_target = nullptr;
+
+                if (depth == 0)
+                {
+                    if (local_name != "property_file")
+                    {
+                        setError("property_file");
+                    }
+                }
+                else if (depth == 1)
+                {
+                    if (local_name == "system_timing_properties")
+                    {
+                        _section = Section::system_timing_properties;
+                    }
+                    else if (local_name == "system_properties")
+                    {
+                        _section = Section::system_properties;
+                    }
+                    else if (local_name == "element_instances_properties")
+                    {
+                        _section = Section::element_instances_properties;
+                    }
+                    else
+                    {
+                        _section = Section::none;
+                    }
+                }
+                else if (_property._active)
+                {
+                    if (depth == _property._depth + 1)
+                    {
+                        if (local_name == "name")
+                        {
+                            _property._has_name = true;
+                            _text_target = &_property._property._name;
+                        }
+                        else if (local_name == "type")
+                        {
+                            _property._has_type = true;
+                            _text_target = &_property._property._type;
+                        }
+                        else if (local_name == "value")
+                        {
+                            _property._has_value = true;
+                            _text_target = &_property._property._value;
+                        }
+                    }
+                }
+                else if (_section == Section::system_timing_properties || _section == Section::system_properties)
+                {
+                    if (depth == 2 && local_name == "property")
+                    {
+                        startProperty(depth);
+                    }
+                }
+                else if (_section == Section::element_instances_properties)
+                {
+                    if (depth == 2 && local_name == "element_instance")
+                    {
+                        _element_instance = ElementInstanceState();
+                        _element_instance._active = true;
+                    }
+                    else if (depth == 3 && _element_instance._active)
+                    {
+                        if (local_name == "id")
+                        {
+                            _element_instance._has_id = true;
+                            _text_target = &_element_instance._id;
+                        }
+                        else if (local_name == "properties")
+                        {
+                            _element_instance._has_properties = true;
+                        }
+                    }
+                    else if (depth == 4 && _element_instance._active
+                             && _path[3] == "properties" && local_name == "property")
+                    {
+                        startProperty(depth);
+                    }
+                }
+            }
+
+            void onEndElement(const std::string&) override
+            {
+                const size_t depth = _path.size() - 1;
+                _path.pop_back();
+                _text_target = nullptr;
+
+                if (_property._active && depth == _property._depth)
+                {
+                    finishProperty();
+                }
+                else if (depth == 2 && _element_instance._active)
+                {
+                    finishElementInstance();
+                }
+                else if (depth == 1)
+                {
+                    _section = Section::none;
+                }
+            }
+
+            void onText(const std::string& text) override
+            {
+                if (_text_target)
+                {
+                    _text_target->append(text);
+                }
+            }
+
+            bool hasError() const
+            {
+                return !_error.empty();
+            }
+
+            const std::string& getError() const
+            {
+                return _error;
+            }
+
+            PropertyTable makeTable()
+            {
+                //the element properties are within the columns already, the few system ones follow them
+                auto system_timing_properties = addPropertyList(_system_timing_properties);
+                auto system_properties = addPropertyList(_system_properties);
+                return PropertyTable(std::move(system_timing_properties),
+                                     std::move(system_properties),
+                                     std::move(_element_instances));
+            }
+
+        private:
+            PropertyList addPropertyList(const std::vector<PropertyAssignment>& properties)
+            {
+                for (const auto& property : properties)
+                {
+                    _columns.add(property._name, property._type, property._value);
+                }
+                return _columns.finishList();
+            }
+
+            void setError(const char* missing_element)
+            {
+                if (_error.empty())
+                {
+                    _error = a_util::strings::format("element \"%s\" not found", missing_element);
+                }
+            }
+
+            void startProperty(size_t depth)
+            {
+                _property = PropertyState();
+                _property._active = true;
+                _property._depth = depth;
+            }
+
+            void finishProperty()
+            {
+                _property._active = false;
+                if (!_property._has_name)
+                {
+                    setError("name");
+                }
+                else if (!_property._has_type)
+                {
+                    setError("type");
+                }
+                else if (!_property._has_value)
+                {
+                    setError("value");
+                }
+                if (hasError())
+                {
+                    return;
+                }
+
+                switch (_section)
+                {
+                case Section::system_timing_properties:
+                    _system_timing_properties.push_back(std::move(_property._property));
+                    break;
+                case Section::system_properties:
+                    _system_properties.push_back(std::move(_property._property));
+                    break;
+                case Section::element_instances_properties:
+                    //the properties of an element instance are added to the columns right away
+                    _columns.add(_property._property._name, _property._property._type, _property._property._value);
+                    break;
+                case Section::none:
+                    break;
+                }
+            }
+
+            void finishElementInstance()
+            {
+                _element_instance._active = false;
+                if (!_element_instance._has_id)
+                {
+                    setError("id");
+                }
+                else if (!_element_instance._has_properties)
+                {
+                    setError("properties");
+                }
+                if (hasError())
+                {
+                    return;
+                }
+                _element_instances.push_back({ std::move(_element_instance._id), _columns.finishList() });
+            }
+
+        private:
+            std::vector<std::string> _path;
+            Section _section = Section::none;
+            std::string* _text_target = nullptr;
+            PropertyState _property;
+            ElementInstanceState _element_instance;
+            std::vector<PropertyAssignment> _system_timing_properties;
+            std::vector<PropertyAssignment> _system_properties;
+            PropertyListBuilder _columns;
+            std::vector<PropertyTable::ElementInstance> _element_instances;
+            std::string _error;
+        };
+    }
+
+    PropertyTable streamPropertyTable(const std::string& system_properties_file)
+    {
+        TraceScope trace("xml.stream_parse", std::string(), system_properties_file);
+        std::ifstream file_stream(system_properties_file, std::ios::in | std::ios::binary);
+        if (!file_stream.is_open())
+        {
+            throw std::runtime_error(a_util::strings::format("xml parse error for file '%s' : %s",
+                system_properties_file.c_str(),
+                "File was not found"));
+        }
+
+        PropertyFileStreamHandler handler;
+        XmlStreamReader reader(*file_stream.rdbuf());
+        if (!reader.read(handler))
+        {
+            throw std::runtime_error(a_util::strings::format("xml parse error for file '%s' : %s",
+                system_properties_file.c_str(),
+                reader.getLastError().c_str()));
+        }
+
+        if (handler.hasError())
+        {
+            throw std::runtime_error(a_util::strings::format("fep sdk system properties data model parse error for file '%s' : %s",
+                system_properties_file.c_str(),
+                handler.getError().c_str()));
+        }
+
+        return handler.makeTable();
+    }
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,348 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "property_table.h"
+
+#include <a_util/strings.h>
+
+#include <limits>
+#include <set>
+#include <stdexcept>
+
+using namespace fep::metamodel;
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    PropertyColumns::PropertyColumns()
+        : _value_offsets(1, 0)
+    {
+    }
+
+    uint32_t PropertyColumns::intern(const std::string& text)
+    {
+        auto found = _interned_ids.find(std::cref(text));
+        if (found != _interned_ids.end())
+        {
+            return found->second;
+        }
+        const auto id = static_cast<uint32_t>(_interned.size());
+        _interned.push_back(text);
+        _interned_ids.emplace(std::cref(_interned.back()), id);
+        return id;
+    }
+
+    size_t PropertyColumns::add(const std::string& name, const std::string& type, const std::string& value)
+    {
+        if (value.size() > std::numeric_limits<uint32_t>::max() - _values.size())
+        {
+            throw std::runtime_error(a_util::strings::format(
+                "the values of the properties exceed %u bytes at the property %s",
+                std::numeric_limits<uint32_t>::max(), name.c_str()));
+        }
+        _name_ids.push_back(intern(name));
+        _type_ids.push_back(intern(type));
+        _values.append(value);
+        _value_offsets.push_back(static_cast<uint32_t>(_values.size()));
+        return _name_ids.size() - 1;
+    }
+
+    size_t PropertyColumns::size() const
+    {
+        return _name_ids.size();
+    }
+
+    uint32_t PropertyColumns::getNameId(size_t position) const
+    {
+        return _name_ids[position];
+    }
+
+    const std::string& PropertyColumns::getName(size_t position) const
+    {
+        return _interned[_name_ids[position]];
+    }
+
+    const std::string& PropertyColumns::getType(size_t position) const
+    {
+        return _interned[_type_ids[position]];
+    }
+
+    std::string PropertyColumns::getValue(size_t position) const
+    {
+        return _values.substr(_value_offsets[position], _value_offsets[position + 1] - _value_offsets[position]);
+    }
+
+    bool PropertyColumns::hasValue(size_t position, const std::string& value) const
+    {
+        const size_t length = _value_offsets[position + 1] - _value_offsets[position];
+        return length == value.size()
+            && _values.compare(_value_offsets[position], length, value) == 0;
+    }
+
+    bool PropertyColumns::findInterned(const std::string& text, uint32_t& id) const
+    {
+        auto found = _interned_ids.find(std::cref(text));
+        if (found == _interned_ids.end())
+        {
+            return false;
+        }
+        id = found->second;
+        return true;
+    }
+
+    void PropertyColumns::indexList(size_t first, size_t count)
+    {
+        for (size_t position = first; position < first + count; ++position)
+        {
+            _list_index.emplace((static_cast<uint64_t>(first) << 32) | _name_ids[position], position);
+        }
+    }
+
+    bool PropertyColumns::findInList(size_t first, uint32_t name_id, size_t& position) const
+    {
+        auto found = _list_index.find((static_cast<uint64_t>(first) << 32) | name_id);
+        if (found == _list_index.end())
+        {
+            return false;
+        }
+        position = found->second;
+        return true;
+    }
+
+    size_t PropertyColumns::estimateMemoryUsage() const
+    {
+        //every interned string is referenced by one index node (key reference, value and the bucket pointer)
+        const size_t index_entry_size = sizeof(void*) * 4 + sizeof(uint32_t);
+        size_t bytes = sizeof(PropertyColumns)
+            + _name_ids.capacity() * sizeof(uint32_t)
+            + _type_ids.capacity() * sizeof(uint32_t)
+            + _value_offsets.capacity() * sizeof(uint32_t)
+            + _values.capacity()
+            + _list_index.bucket_count() * sizeof(void*)
+            + _list_index.size() * (sizeof(void*) + sizeof(uint64_t) + sizeof(size_t));
+        for (const auto& text : _interned)
+        {
+            bytes += sizeof(std::string) + text.capacity() + index_entry_size;
+        }
+        return bytes;
+    }
+
+    PropertyList::PropertyList(const std::vector<PropertyAssignment>& properties)
+    {
+        PropertyListBuilder builder;
+        for (const auto& property : properties)
+        {
+            builder.add(property._name, property._type, property._value);
+        }
+        *this = builder.finishList();
+    }
+
+    PropertyList::PropertyList(std::shared_ptr<const PropertyColumns> columns, size_t first, size_t count)
+        : _columns(std::move(columns)),
+          _first(first),
+          _count(count)
+    {
+    }
+
+    bool PropertyList::empty() const
+    {
+        return _count == 0;
+    }
+
+    size_t PropertyList::size() const
+    {
+        return _count;
+    }
+
+    const std::string& PropertyList::getName(size_t index) const
+    {
+        return _columns->getName(_first + index);
+    }
+
+    const std::string& PropertyList::getType(size_t index) const
+    {
+        return _columns->getType(_first + index);
+    }
+
+    std::string PropertyList::getValue(size_t index) const
+    {
+        return _columns->getValue(_first + index);
+    }
+
+    bool PropertyList::hasValue(size_t index, const std::string& value) const
+    {
+        return _columns->hasValue(_first + index, value);
+    }
+
+    PropertyAssignment PropertyList::getProperty(size_t index) const
+    {
+        return { getName(index), getType(index), getValue(index) };
+    }
+
+    std::vector<PropertyAssignment> PropertyList::getProperties() const
+    {
+        std::vector<PropertyAssignment> properties;
+        properties.reserve(_count);
+        for (size_t index = 0; index < _count; ++index)
+        {
+            properties.push_back(getProperty(index));
+        }
+        return properties;
+    }
+
+    bool PropertyList::find(const std::string& name, size_t& index) const
+    {
+        uint32_t name_id = 0;
+        size_t position = 0;
+        if (_count == 0 || !_columns->findInterned(name, name_id) || !_columns->findInList(_first, name_id, position))
+        {
+            return false;
+        }
+        index = position - _first;
+        return true;
+    }
+
+    std::string PropertyList::getValue(const std::string& name, const std::string& default_value) const
+    {
+        size_t index = 0;
+        return find(name, index) ? getValue(index) : default_value;
+    }
+
+    const std::shared_ptr<const PropertyColumns>& PropertyList::getColumns() const
+    {
+        return _columns;
+    }
+
+    PropertyListBuilder::PropertyListBuilder()
+        : _columns(std::make_shared<PropertyColumns>())
+    {
+    }
+
+    void PropertyListBuilder::add(const std::string& name, const std::string& type, const std::string& value)
+    {
+        _columns->add(name, type, value);
+    }
+
+    PropertyList PropertyListBuilder::finishList()
+    {
+        const size_t first = _first;
+        _first = _columns->size();
+        _columns->indexList(first, _first - first);
+        return PropertyList(_columns, first, _first - first);
+    }
+
+    PropertyTable::PropertyTable(PropertyList system_timing_properties,
+                                 PropertyList system_properties,
+                                 std::vector<ElementInstance> element_instances)
+        : _system_timing_properties(std::move(system_timing_properties)),
+          _system_properties(std::move(system_properties)),
+          _element_instances(std::move(element_instances))
+    {
+        _element_index.reserve(_element_instances.size());
+        for (size_t index = 0; index < _element_instances.size(); ++index)
+        {
+            _element_index.emplace(_element_instances[index]._id, index);
+        }
+    }
+
+    const PropertyList& PropertyTable::getSystemTimingProperties() const
+    {
+        return _system_timing_properties;
+    }
+
+    const PropertyList& PropertyTable::getSystemProperties() const
+    {
+        return _system_properties;
+    }
+
+    const std::vector<PropertyTable::ElementInstance>& PropertyTable::getElementInstances() const
+    {
+        return _element_instances;
+    }
+
+    const PropertyList* PropertyTable::findElementProperties(const std::string& element_id) const
+    {
+        auto found = _element_index.find(element_id);
+        if (found != _element_index.end())
+        {
+            return &_element_instances[found->second]._properties;
+        }
+        return nullptr;
+    }
+
+    namespace
+    {
+        PropertyList addPropertyList(PropertyListBuilder& builder, std::vector<Property>& properties)
+        {
+            for (const Property& file_property : properties)
+            {
+                builder.add(file_property._name, file_property._type, file_property._value);
+            }
+            //the parsed strings are released as soon as they are within the columns
+            std::vector<Property>().swap(properties);
+            return builder.finishList();
+        }
+    }
+
+    PropertyTable makePropertyTable(PropertyFile&& property_file)
+    {
+        PropertyListBuilder builder;
+        auto system_timing_properties = addPropertyList(builder, property_file._system_timing_properties);
+        auto system_properties = addPropertyList(builder, property_file._system_properties);
+        std::vector<PropertyTable::ElementInstance> element_instances;
+        element_instances.reserve(property_file._element_instances_properties.size());
+        for (auto& element_instance : property_file._element_instances_properties)
+        {
+            element_instances.push_back({ std::move(element_instance._id),
+                                          addPropertyList(builder, element_instance._properties) });
+        }
+        return PropertyTable(std::move(system_timing_properties),
+                             std::move(system_properties),
+                             std::move(element_instances));
+    }
+
+    size_t estimateMemoryUsage(const PropertyTable& property_table)
+    {
+        //the lists of a table usually share one set of columns, each set is counted once
+        std::set<const PropertyColumns*> counted_columns;
+        auto estimate_list = [&counted_columns](const PropertyList& property_list)
+        {
+            size_t bytes = sizeof(PropertyList);
+            const auto& columns = property_list.getColumns();
+            if (columns && counted_columns.insert(columns.get()).second)
+            {
+                bytes += columns->estimateMemoryUsage();
+            }
+            return bytes;
+        };
+        size_t bytes = sizeof(PropertyTable)
+            + estimate_list(property_table.getSystemTimingProperties())
+            + estimate_list(property_table.getSystemProperties());
+        for (const auto& element_instance : property_table.getElementInstances())
+        {
+            bytes += sizeof(PropertyTable::ElementInstance)
+                + element_instance._id.capacity() * 2 //the id is also the key of the element index
+                + estimate_list(element_instance._properties);
+        }
+        return bytes;
+    }
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,228 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/property_batch_writer_intf.h>
+#include <fep_metamodel/fep_system.h>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+struct PropertyOverlay;
+
+namespace detail
+{
+    /**
+     * The properties of a property file stored column by column (struct of arrays).
+     * Names and types repeat across the element instances, each distinct one is stored once (interned)
+     * and referred to by its id. The values are appended to one contiguous buffer.
+     * The properties of every finished list are indexed by list and name id in one hash map.
+     * Filled once while the file is parsed (see @ref PropertyListBuilder) and only read afterwards,
+     * so it may be read concurrently.
+     */
+    class PropertyColumns
+    {
+    public:
+        PropertyColumns();
+
+        /**
+         * Appends a property
+         *
+         * @return the position of the property within the columns
+         * @throws std::runtime_error if the values exceed the size of the buffer
+         */
+        size_t add(const std::string& name, const std::string& type, const std::string& value);
+        /// @return the number of properties within the columns
+        size_t size() const;
+        /// @return the interned name id of the property at @p position
+        uint32_t getNameId(size_t position) const;
+        const std::string& getName(size_t position) const;
+        const std::string& getType(size_t position) const;
+        std::string getValue(size_t position) const;
+        /// @return true if the value of the property at @p position is @p value, without copying it
+        bool hasValue(size_t position, const std::string& value) const;
+        /**
+         * @param [in] text the name or type to look up
+         * @param [out] id the id of @p text if it is interned
+         * @return false if no property has the name or type @p text
+         */
+        bool findInterned(const std::string& text, uint32_t& id) const;
+        /**
+         * Indexes the names of the list at [@p first, @p first + @p count), the first property of a name wins
+         */
+        void indexList(size_t first, size_t count);
+        /**
+         * @param [in] first the position of the first property of an indexed list
+         * @param [in] name_id the interned name id to look up
+         * @param [out] position the position of the property named @p name_id within the list
+         * @return false if the list has no property named @p name_id
+         */
+        bool findInList(size_t first, uint32_t name_id, size_t& position) const;
+        /// @return the estimated heap and object memory used by the columns in bytes
+        size_t estimateMemoryUsage() const;
+
+    private:
+        uint32_t intern(const std::string& text);
+
+    private:
+        //a deque keeps its elements in place, the keys of _interned_ids refer to them
+        std::deque<std::string> _interned;
+        std::unordered_map<std::reference_wrapper<const std::string>, uint32_t,
+                           std::hash<std::string>, std::equal_to<std::string>> _interned_ids;
+        std::vector<uint32_t> _name_ids;
+        std::vector<uint32_t> _type_ids;
+        //the value at position i is [_value_offsets[i], _value_offsets[i + 1]) of _values
+        std::vector<uint32_t> _value_offsets;
+        std::string _values;
+        //the key is the position of the first property of the list (upper half) and the name id (lower half)
+        std::unordered_map<uint64_t, size_t> _list_index;
+    };
+
+    /**
+     * List of properties, a range of the columns of a property file.
+     * Copies share the columns (which stay alive as long as one list refers to them).
+     * If a name occurs more than once the first property wins (as within the property file).
+     */
+    class PropertyList
+    {
+    public:
+        PropertyList() = default;
+        /// Copies @p properties into columns of its own
+        explicit PropertyList(const std::vector<PropertyAssignment>& properties);
+        /**
+         * @param [in] columns the columns holding the properties,
+         *                    the list must be indexed (see @ref PropertyColumns::indexList)
+         * @param [in] first the position of the first property of the list within @p columns
+         * @param [in] count the number of properties of the list
+         */
+        PropertyList(std::shared_ptr<const PropertyColumns> columns, size_t first, size_t count);
+
+        bool empty() const;
+        size_t size() const;
+        /// @return the name of the property at @p index (in file order)
+        const std::string& getName(size_t index) const;
+        /// @return the type of the property at @p index
+        const std::string& getType(size_t index) const;
+        /// @return the value of the property at @p index
+        std::string getValue(size_t index) const;
+        /// @return true if the value of the property at @p index is @p value
+        bool hasValue(size_t index, const std::string& value) const;
+        /// @return the property at @p index
+        PropertyAssignment getProperty(size_t index) const;
+        /// @return copies of the properties in file order (as passed to the batch writers)
+        std::vector<PropertyAssignment> getProperties() const;
+        /**
+         * Looks up a property by name within the index of the columns
+         *
+         * @param [in] name the name of the property
+         * @param [out] index the index of the first property named @p name
+         * @return false if there is no property named @p name
+         */
+        bool find(const std::string& name, size_t& index) const;
+        /// @return the value of the property @p name, @p default_value if there is none
+        std::string getValue(const std::string& name, const std::string& default_value) const;
+        /// @return the columns holding the properties, nullptr for an empty default constructed list
+        const std::shared_ptr<const PropertyColumns>& getColumns() const;
+
+    private:
+        std::shared_ptr<const PropertyColumns> _columns;
+        size_t _first = 0;
+        size_t _count = 0;
+    };
+
+    /**
+     * Fills the columns of a property file list by list.
+     * All lists built by one builder share its columns.
+     */
+    class PropertyListBuilder
+    {
+    public:
+        PropertyListBuilder();
+
+        /// Appends a property to the current list
+        void add(const std::string& name, const std::string& type, const std::string& value);
+        /// @return the properties added since the last call (or since construction) as list
+        PropertyList finishList();
+
+    private:
+        std::shared_ptr<PropertyColumns> _columns;
+        size_t _first = 0;
+    };
+
+    /**
+     * The content of a property file as used by the controller,
+     * indexed once by element id and property name.
+     */
+    class PropertyTable
+    {
+    public:
+        /// Properties of one element instance
+        struct ElementInstance
+        {
+            std::string _id;
+            PropertyList _properties;
+        };
+
+    public:
+        PropertyTable() = default;
+        PropertyTable(PropertyList system_timing_properties,
+                      PropertyList system_properties,
+                      std::vector<ElementInstance> element_instances);
+
+        const PropertyList& getSystemTimingProperties() const;
+        const PropertyList& getSystemProperties() const;
+        /// @return all element instances in file order
+        const std::vector<ElementInstance>& getElementInstances() const;
+        /// @return the properties of the first element instance with the id @p element_id, nullptr if there is none
+        const PropertyList* findElementProperties(const std::string& element_id) const;
+
+    private:
+        PropertyList _system_timing_properties;
+        PropertyList _system_properties;
+        std::vector<ElementInstance> _element_instances;
+        std::unordered_map<std::string, size_t> _element_index;
+    };
+
+    /**
+     * Copies the content of a parsed property file into the columns of a property table
+     * and releases the properties of @p property_file on the way.
+     */
+    PropertyTable makePropertyTable(fep::metamodel::PropertyFile&& property_file);
+
+    /**
+     * @return the estimated heap and object memory used by @p property_table in bytes
+     */
+    size_t estimateMemoryUsage(const PropertyTable& property_table);
+
+    /**
+     * @return @p base with the overrides of @p overlay applied
+     * @throws std::runtime_error if a property added by @p overlay has no type
+     */
+    PropertyTable mergeOverlay(const PropertyTable& base, const PropertyOverlay& overlay);
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,333 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/deadlines.h>
+#include <a_util/strings.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    using DeadlineClock = std::chrono::steady_clock;
+
+    /**
+     * @return the point in time @p limit after @p begin, the maximum time point if @p limit is 0
+     */
+    inline DeadlineClock::time_point makeDeadline(DeadlineClock::time_point begin, std::chrono::milliseconds limit)
+    {
+        return limit.count() > 0 ? begin + limit : DeadlineClock::time_point::max();
+    }
+
+    /**
+     * The deadline of a whole configure operation, started on construction
+     */
+    class OperationDeadline
+    {
+    public:
+        explicit OperationDeadline(std::chrono::milliseconds limit)
+            : _limit(limit),
+              _deadline(makeDeadline(DeadlineClock::now(), limit))
+        {
+        }
+
+        DeadlineClock::time_point get() const
+        {
+            return _deadline;
+        }
+
+        /**
+         * @return the time left (at least 1ms), 0 if there is no limit
+         * @throws DeadlineExceededError if the deadline expired
+         */
+        std::chrono::milliseconds getRemaining(const std::string& step) const
+        {
+            if (_limit.count() == 0)
+            {
+                return std::chrono::milliseconds(0);
+            }
+            throwIfExpired(step);
+            return std::max(std::chrono::milliseconds(1),
+                            std::chrono::duration_cast<std::chrono::milliseconds>(_deadline - DeadlineClock::now()));
+        }
+
+        /**
+         * @throws DeadlineExceededError if the deadline expired
+         */
+        void throwIfExpired(const std::string& step) const
+        {
+            if (DeadlineClock::now() >= _deadline)
+            {
+                throw DeadlineExceededError(a_util::strings::format("the operation deadline of %lld ms expired before %s",
+                    static_cast<long long>(_limit.count()),
+                    step.c_str()));
+            }
+        }
+
+    private:
+        const std::chrono::milliseconds _limit;
+        const DeadlineClock::time_point _deadline;
+    };
+
+    /**
+     * The thread running the requests of one RequestRunner while a deadline is set,
+     * so the runner can stop waiting for a stalled request.
+     * An abandoned thread ends after its current request, the next request starts a new thread.
+     */
+    class RequestThread
+    {
+    public:
+        RequestThread() = default;
+        RequestThread(const RequestThread&) = delete;
+        RequestThread& operator=(const RequestThread&) = delete;
+
+        ~RequestThread()
+        {
+            abandon();
+        }
+
+        /**
+         * Runs @p job on the thread, starting the thread if there is none.
+         * The job posted before must have returned or been abandoned.
+         * @throws std::system_error if the thread can not be started
+         */
+        void post(std::function<void()> job)
+        {
+            if (!_state)
+            {
+                auto state = std::make_shared<State>();
+                //the thread keeps its state alive, it might outlive this object
+                std::thread([state]() { runJobs(*state); }).detach();
+                _state = state;
+            }
+            std::lock_guard<std::mutex> lock(_state->_mutex);
+            _state->_job = std::move(job);
+            _state->_changed.notify_one();
+        }
+
+        /**
+         * Lets the thread end after its current job, without waiting for it
+         */
+        void abandon()
+        {
+            if (!_state)
+            {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_state->_mutex);
+                _state->_abandoned = true;
+            }
+            _state->_changed.notify_one();
+            _state.reset();
+        }
+
+    private:
+        struct State
+        {
+            std::mutex _mutex;
+            std::condition_variable _changed;
+            std::function<void()> _job;
+            bool _abandoned = false;
+        };
+
+        static void runJobs(State& state)
+        {
+            std::unique_lock<std::mutex> lock(state._mutex);
+            for (;;)
+            {
+                state._changed.wait(lock, [&]() { return state._job || state._abandoned; });
+                if (!state._job)
+                {
+                    return;
+                }
+                auto job = std::move(state._job);
+                state._job = nullptr;
+                lock.unlock();
+                job();
+                lock.lock();
+            }
+        }
+
+    private:
+        std::shared_ptr<State> _state;
+    };
+
+    /**
+     * Runs the requests to one participant within the deadlines and retries the ones failing transiently.
+     * Used by one thread at a time.
+     *
+     * While a deadline is set, the requests run on a RequestThread and are abandoned if they do not
+     * return in time. An abandoned request keeps running, so a request must not refer to anything
+     * it does not own (capture by value or by shared pointer).
+     */
+    class RequestRunner
+    {
+    public:
+        RequestRunner(const std::string& participant_name,
+                      const DeadlineOptions& deadlines,
+                      const RetryOptions& retry,
+                      const OperationDeadline& operation_deadline)
+            : _participant_name(participant_name),
+              _request_deadline(deadlines._request_deadline),
+              _retry(retry),
+              _deadline(std::min(operation_deadline.get(),
+                                 makeDeadline(DeadlineClock::now(), deadlines._participant_deadline)))
+        {
+        }
+
+        /**
+         * Runs @p request until it succeeds, the retries are used up or the deadline expired.
+         * A request not returning within the request deadline or the deadline is abandoned and not retried,
+         * since it might not be safe to send it again. A failed request is only retried
+         * if the time left until the deadline is at least the request deadline.
+         *
+         * @return the result of @p request
+         * @throws DeadlineExceededError if the deadline expired, the request was abandoned
+         *         or there is no time left for a retry
+         * @throws std::runtime_error the error of the last attempt
+         */
+        template <typename Request>
+        auto run(const char* request_name, Request request) -> decltype(request())
+        {
+            for (size_t attempt = 0;; ++attempt)
+            {
+                throwIfExpired(request_name);
+                std::string error;
+                try
+                {
+                    return call(request_name, request);
+                }
+                catch (const DeadlineExceededError&)
+                {
+                    throw;
+                }
+                catch (const std::runtime_error& exception)
+                {
+                    if (attempt >= _retry._max_retries)
+                    {
+                        throw;
+                    }
+                    error = exception.what();
+                }
+                waitBeforeRetry(attempt);
+                throwIfNoTimeForRetry(request_name, error);
+            }
+        }
+
+    private:
+        template <typename Request>
+        auto call(const char* request_name, const Request& request) -> decltype(request())
+        {
+            const auto request_deadline = makeDeadline(DeadlineClock::now(), _request_deadline);
+            if (request_deadline == DeadlineClock::time_point::max() && _deadline == DeadlineClock::time_point::max())
+            {
+                return request();
+            }
+            using Result = decltype(request());
+            auto task = std::make_shared<std::packaged_task<Result()>>(request);
+            auto result = task->get_future();
+            _thread.post([task]() { (*task)(); });
+            if (result.wait_until(std::min(request_deadline, _deadline)) == std::future_status::timeout)
+            {
+                _thread.abandon();
+                if (request_deadline < _deadline)
+                {
+                    throw DeadlineExceededError(a_util::strings::format(
+                        "request %s of participant %s did not return within the request deadline of %lld ms and was abandoned",
+                        request_name,
+                        _participant_name.c_str(),
+                        static_cast<long long>(_request_deadline.count())));
+                }
+                throw DeadlineExceededError(a_util::strings::format(
+                    "the deadline of participant %s expired during request %s, the request was abandoned",
+                    _participant_name.c_str(),
+                    request_name));
+            }
+            return result.get();
+        }
+
+        void throwIfExpired(const char* request_name) const
+        {
+            if (DeadlineClock::now() >= _deadline)
+            {
+                throw DeadlineExceededError(a_util::strings::format("the deadline of participant %s expired before request %s",
+                    _participant_name.c_str(),
+                    request_name));
+            }
+        }
+
+        void throwIfNoTimeForRetry(const char* request_name, const std::string& error) const
+        {
+            if (_request_deadline.count() > 0 && _deadline - DeadlineClock::now() < _request_deadline)
+            {
+                throw DeadlineExceededError(a_util::strings::format(
+                    "the deadline of participant %s leaves less than the request deadline of %lld ms to retry request %s: %s",
+                    _participant_name.c_str(),
+                    static_cast<long long>(_request_deadline.count()),
+                    request_name,
+                    error.c_str()));
+            }
+        }
+
+        void waitBeforeRetry(size_t attempt)
+        {
+            const double backoff = std::min(
+                static_cast<double>(_retry._initial_backoff.count()) * std::pow(_retry._backoff_multiplier, static_cast<double>(attempt)),
+                static_cast<double>(_retry._max_backoff.count()));
+            //the jitter keeps the retries of concurrently failing participants apart
+            if (!_engine_seeded)
+            {
+                _engine.seed(std::random_device()());
+                _engine_seeded = true;
+            }
+            std::uniform_real_distribution<double> distribution(backoff / 2.0, backoff);
+            const auto wake_up = DeadlineClock::now()
+                + std::chrono::duration_cast<DeadlineClock::duration>(
+                    std::chrono::duration<double, std::milli>(distribution(_engine)));
+            //the expired deadline is reported by the next attempt
+            std::this_thread::sleep_until(std::min(wake_up, _deadline));
+        }
+
+    private:
+        const std::string& _participant_name;
+        const std::chrono::milliseconds _request_deadline;
+        const RetryOptions& _retry;
+        const DeadlineClock::time_point _deadline;
+        std::mt19937 _engine;
+        bool _engine_seeded = false;
+        RequestThread _thread;
+    };
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,94 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "fep_controller/resolved_paths.h"
+#include "path_normalization.h"
+
+#include <unordered_map>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    struct ResolvedPathsData
+    {
+        // keyed by "<base directory>\n<file reference>", a newline is part of neither
+        std::unordered_map<std::string, std::string> _paths;
+    };
+
+    namespace
+    {
+        std::string makeKey(const std::string& file_reference, const std::string& base_directory)
+        {
+            std::string key;
+            key.reserve(base_directory.size() + 1 + file_reference.size());
+            key.append(base_directory).append(1, '\n').append(file_reference);
+            return key;
+        }
+    }
+} // namespace detail
+
+ResolvedPaths::ResolvedPaths()
+    : _data(new detail::ResolvedPathsData())
+{
+}
+
+ResolvedPaths::~ResolvedPaths() = default;
+
+ResolvedPaths::ResolvedPaths(ResolvedPaths&& other)
+    : _data(new detail::ResolvedPathsData())
+{
+    std::swap(_data, other._data);
+}
+
+ResolvedPaths& ResolvedPaths::operator=(ResolvedPaths&& other)
+{
+    std::swap(_data, other._data);
+    return *this;
+}
+
+const std::string& ResolvedPaths::resolve(const std::string& file_reference, const std::string& base_directory)
+{
+    auto key = detail::makeKey(file_reference, base_directory);
+    auto found = _data->_paths.find(key);
+    if (found == _data->_paths.end())
+    {
+        const std::string resolved = detail::normalizeToAnotherPath(file_reference, base_directory);
+        found = _data->_paths.emplace(std::move(key), resolved).first;
+    }
+    return found->second;
+}
+
+const std::string* ResolvedPaths::find(const std::string& file_reference, const std::string& base_directory) const
+{
+    auto found = _data->_paths.find(detail::makeKey(file_reference, base_directory));
+    return found != _data->_paths.end() ? &found->second : nullptr;
+}
+
+size_t ResolvedPaths::size() const
+{
+    return _data->_paths.size();
+}
+
+void ResolvedPaths::clear()
+{
+    _data->_paths.clear();
+}
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,373 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "snapshot_format.h"
+#include "mapped_file.h"
+#include "description_loader.h"
+#include "trace_scope.h"
+
+#include <fep_controller/fep_controller.h>
+#include <a_util/strings.h>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    namespace
+    {
+        constexpr uint64_t checksum_offset_basis = 14695981039346656037ull;
+
+        /**
+         * FNV-1a over 64 bit words, every changed word changes the checksum
+         * @p size must be a multiple of 8
+         */
+        uint64_t updateChecksum(uint64_t checksum, const char* data, size_t size)
+        {
+            for (size_t offset = 0; offset < size; offset += sizeof(uint64_t))
+            {
+                uint64_t word;
+                std::memcpy(&word, data + offset, sizeof(word));
+                checksum ^= word;
+                checksum *= 1099511628211ull;
+            }
+            return checksum;
+        }
+
+        class SnapshotWriter
+        {
+        public:
+            SnapshotString addString(const std::string& text)
+            {
+                auto found = _strings.find(text);
+                if (found != _strings.end())
+                {
+                    return found->second;
+                }
+                if (_string_pool.size() + text.size() > std::numeric_limits<uint32_t>::max())
+                {
+                    throw std::runtime_error("the content is too large for a snapshot");
+                }
+                const SnapshotString snapshot_string{ static_cast<uint32_t>(_string_pool.size()),
+                                                      static_cast<uint32_t>(text.size()) };
+                _string_pool.append(text);
+                _strings.emplace(text, snapshot_string);
+                return snapshot_string;
+            }
+
+            template <typename Record>
+            void addRecord(const Record& record)
+            {
+                _records.append(reinterpret_cast<const char*>(&record), sizeof(record));
+            }
+
+            void write(SnapshotContent content, const std::string& snapshot_file)
+            {
+                _string_pool.append((8 - _string_pool.size() % 8) % 8, '\0');
+
+                SnapshotHeader header;
+                std::memset(&header, 0, sizeof(header));
+                std::memcpy(header._magic, snapshot_magic, sizeof(header._magic));
+                header._version = snapshot_version;
+                header._content = content;
+                header._byte_order_mark = snapshot_byte_order_mark;
+                header._string_pool_offset = sizeof(header) + _records.size();
+                header._string_pool_size = _string_pool.size();
+                header._file_size = header._string_pool_offset + header._string_pool_size;
+                header._checksum = updateChecksum(updateChecksum(checksum_offset_basis, _records.data(), _records.size()),
+                                                  _string_pool.data(), _string_pool.size());
+
+                std::ofstream stream(snapshot_file, std::ios::binary | std::ios::trunc);
+                stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                stream.write(_records.data(), static_cast<std::streamsize>(_records.size()));
+                stream.write(_string_pool.data(), static_cast<std::streamsize>(_string_pool.size()));
+                stream.close();
+                if (!stream)
+                {
+                    throw std::runtime_error(a_util::strings::format("the snapshot '%s' can not be written",
+                        snapshot_file.c_str()));
+                }
+            }
+
+        private:
+            std::string _records;
+            std::string _string_pool;
+            std::unordered_map<std::string, SnapshotString> _strings;
+        };
+
+        /**
+         * Maps a snapshot and checks its header and checksum, the records are read in place
+         */
+        class SnapshotReader
+        {
+        public:
+            SnapshotReader(const std::string& snapshot_file, SnapshotContent content)
+                : _snapshot_file(snapshot_file),
+                  _file(snapshot_file)
+            {
+                if (_file.getSize() < sizeof(SnapshotHeader))
+                {
+                    fail("the file is too small");
+                }
+                _header = reinterpret_cast<const SnapshotHeader*>(_file.getData());
+                if (std::memcmp(_header->_magic, snapshot_magic, sizeof(snapshot_magic)) != 0)
+                {
+                    fail("the file does not start with the snapshot magic");
+                }
+                if (_header->_byte_order_mark != snapshot_byte_order_mark)
+                {
+                    fail("the file was written on a platform with a different byte order");
+                }
+                if (_header->_version != snapshot_version)
+                {
+                    fail(a_util::strings::format("the version %u is not supported (expected %u)",
+                        _header->_version, snapshot_version));
+                }
+                if (_header->_content != content)
+                {
+                    fail(content == SnapshotContent::system_description
+                        ? "the file does not contain a system description"
+                        : "the file does not contain system properties");
+                }
+                if (_header->_file_size != _file.getSize()
+                    || _header->_file_size % 8 != 0
+                    || _header->_string_pool_offset < sizeof(SnapshotHeader)
+                    || _header->_string_pool_offset % 8 != 0
+                    || _header->_string_pool_offset + _header->_string_pool_size != _header->_file_size)
+                {
+                    fail("the file is truncated or its layout is corrupted");
+                }
+                const auto checksum = updateChecksum(checksum_offset_basis,
+                                                     _file.getData() + sizeof(SnapshotHeader),
+                                                     _file.getSize() - sizeof(SnapshotHeader));
+                if (checksum != _header->_checksum)
+                {
+                    fail("the checksum does not match");
+                }
+                _string_pool = _file.getData() + _header->_string_pool_offset;
+            }
+
+            /**
+             * @return @p count records of type Record starting at @p offset
+             */
+            template <typename Record>
+            const Record* getRecords(uint64_t offset, uint64_t count) const
+            {
+                if (offset % alignof(Record) != 0
+                    || offset > _header->_string_pool_offset
+                    || count > (_header->_string_pool_offset - offset) / sizeof(Record))
+                {
+                    fail("a record lies outside of the records");
+                }
+                return reinterpret_cast<const Record*>(_file.getData() + offset);
+            }
+
+            std::string getString(const SnapshotString& snapshot_string) const
+            {
+                if (static_cast<uint64_t>(snapshot_string._offset) + snapshot_string._length > _header->_string_pool_size)
+                {
+                    fail("a string lies outside of the string pool");
+                }
+                return std::string(_string_pool + snapshot_string._offset, snapshot_string._length);
+            }
+
+            void fail(const std::string& reason) const
+            {
+                throw std::runtime_error(a_util::strings::format("'%s' is no valid snapshot: %s",
+                    _snapshot_file.c_str(), reason.c_str()));
+            }
+
+        private:
+            const std::string _snapshot_file;
+            MappedFile _file;
+            const SnapshotHeader* _header = nullptr;
+            const char* _string_pool = nullptr;
+        };
+
+        void addProperties(SnapshotWriter& writer, const PropertyList& properties)
+        {
+            for (size_t index = 0; index < properties.size(); ++index)
+            {
+                writer.addRecord(PropertyRecord{ writer.addString(properties.getName(index)),
+                                                 writer.addString(properties.getType(index)),
+                                                 writer.addString(properties.getValue(index)) });
+            }
+        }
+
+        uint32_t toCount(size_t count)
+        {
+            if (count > std::numeric_limits<uint32_t>::max())
+            {
+                throw std::runtime_error("the content is too large for a snapshot");
+            }
+            return static_cast<uint32_t>(count);
+        }
+    }
+
+    bool isSnapshotFile(const std::string& file_path)
+    {
+        const std::string extension = std::string(".") + snapshot_file_extension;
+        return file_path.size() >= extension.size()
+            && file_path.compare(file_path.size() - extension.size(), extension.size(), extension) == 0;
+    }
+
+    void writeSnapshot(const SystemDescription& system_description, const std::string& snapshot_file)
+    {
+        SnapshotWriter writer;
+        writer.addRecord(SystemRecord{ writer.addString(system_description._name),
+                                       toCount(system_description._participants.size()),
+                                       0 });
+        for (const auto& participant : system_description._participants)
+        {
+            ParticipantRecord record;
+            std::memset(&record, 0, sizeof(record));
+            record._name = writer.addString(participant._name);
+            record._init_priority = participant._init_priority;
+            record._start_priority = participant._start_priority;
+            record._flags = (participant._timing._valid ? ParticipantRecord::timing_valid : 0u)
+                | (participant._input_mapping._valid ? ParticipantRecord::input_mapping_valid : 0u)
+                | (participant._output_mapping._valid ? ParticipantRecord::output_mapping_valid : 0u);
+            record._timing = writer.addString(participant._timing._file_reference);
+            record._input_mapping = writer.addString(participant._input_mapping._file_reference);
+            record._output_mapping = writer.addString(participant._output_mapping._file_reference);
+            writer.addRecord(record);
+        }
+        writer.write(SnapshotContent::system_description, snapshot_file);
+    }
+
+    void writeSnapshot(const PropertyTable& property_table, const std::string& snapshot_file)
+    {
+        SnapshotWriter writer;
+        const auto& element_instances = property_table.getElementInstances();
+        size_t property_count = property_table.getSystemTimingProperties().size()
+            + property_table.getSystemProperties().size();
+        for (const auto& element_instance : element_instances)
+        {
+            property_count += element_instance._properties.size();
+        }
+        writer.addRecord(PropertyTableRecord{ toCount(property_table.getSystemTimingProperties().size()),
+                                              toCount(property_table.getSystemProperties().size()),
+                                              toCount(element_instances.size()),
+                                              toCount(property_count) });
+        addProperties(writer, property_table.getSystemTimingProperties());
+        addProperties(writer, property_table.getSystemProperties());
+        for (const auto& element_instance : element_instances)
+        {
+            addProperties(writer, element_instance._properties);
+        }
+        uint32_t first_property = toCount(property_table.getSystemTimingProperties().size()
+            + property_table.getSystemProperties().size());
+        for (const auto& element_instance : element_instances)
+        {
+            const auto element_property_count = toCount(element_instance._properties.size());
+            writer.addRecord(ElementRecord{ writer.addString(element_instance._id), first_property, element_property_count });
+            first_property += element_property_count;
+        }
+        writer.write(SnapshotContent::system_properties, snapshot_file);
+    }
+
+    SystemDescription readSystemDescriptionSnapshot(const std::string& snapshot_file)
+    {
+        const SnapshotReader reader(snapshot_file, SnapshotContent::system_description);
+        const auto system = reader.getRecords<SystemRecord>(sizeof(SnapshotHeader), 1);
+        const auto participants = reader.getRecords<ParticipantRecord>(sizeof(SnapshotHeader) + sizeof(SystemRecord),
+                                                                       system->_participant_count);
+        SystemDescription system_description;
+        system_description._name = reader.getString(system->_name);
+        system_description._participants.resize(system->_participant_count);
+        for (uint32_t index = 0; index < system->_participant_count; ++index)
+        {
+            const auto& record = participants[index];
+            auto& participant = system_description._participants[index];
+            participant._name = reader.getString(record._name);
+            participant._init_priority = record._init_priority;
+            participant._start_priority = record._start_priority;
+            participant._timing._valid = (record._flags & ParticipantRecord::timing_valid) != 0;
+            participant._timing._file_reference = reader.getString(record._timing);
+            participant._input_mapping._valid = (record._flags & ParticipantRecord::input_mapping_valid) != 0;
+            participant._input_mapping._file_reference = reader.getString(record._input_mapping);
+            participant._output_mapping._valid = (record._flags & ParticipantRecord::output_mapping_valid) != 0;
+            participant._output_mapping._file_reference = reader.getString(record._output_mapping);
+        }
+        return system_description;
+    }
+
+    PropertyTable readPropertyTableSnapshot(const std::string& snapshot_file)
+    {
+        const SnapshotReader reader(snapshot_file, SnapshotContent::system_properties);
+        const auto table = reader.getRecords<PropertyTableRecord>(sizeof(SnapshotHeader), 1);
+        const uint64_t properties_offset = sizeof(SnapshotHeader) + sizeof(PropertyTableRecord);
+        const auto properties = reader.getRecords<PropertyRecord>(properties_offset, table->_property_count);
+        const auto elements = reader.getRecords<ElementRecord>(
+            properties_offset + static_cast<uint64_t>(table->_property_count) * sizeof(PropertyRecord),
+            table->_element_count);
+
+        PropertyListBuilder columns;
+        auto read_properties = [&](uint64_t first_property, uint64_t property_count)
+        {
+            if (first_property + property_count > table->_property_count)
+            {
+                reader.fail("a property list lies outside of the properties");
+            }
+            for (uint64_t index = first_property; index < first_property + property_count; ++index)
+            {
+                const auto& record = properties[index];
+                columns.add(reader.getString(record._name),
+                            reader.getString(record._type),
+                            reader.getString(record._value));
+            }
+            return columns.finishList();
+        };
+
+        auto timing_properties = read_properties(0, table->_timing_property_count);
+        auto system_properties = read_properties(table->_timing_property_count, table->_system_property_count);
+        std::vector<PropertyTable::ElementInstance> element_instances(table->_element_count);
+        for (uint32_t index = 0; index < table->_element_count; ++index)
+        {
+            element_instances[index]._id = reader.getString(elements[index]._id);
+            element_instances[index]._properties = read_properties(elements[index]._first_property,
+                                                                   elements[index]._property_count);
+        }
+        return PropertyTable(std::move(timing_properties), std::move(system_properties), std::move(element_instances));
+    }
+} // namespace detail
+
+    void convertSystemDescriptionToSnapshot(const std::string& system_sdk_description_file,
+                                            const std::string& snapshot_file)
+    {
+        detail::TraceScope trace("convertSystemDescriptionToSnapshot", std::string(), system_sdk_description_file);
+        detail::writeSnapshot(*detail::loadSystemDescription(system_sdk_description_file), snapshot_file);
+    }
+
+    void convertSystemPropertiesToSnapshot(const std::string& system_properties_file,
+                                           const std::string& snapshot_file)
+    {
+        detail::TraceScope trace("convertSystemPropertiesToSnapshot", std::string(), system_properties_file);
+        detail::writeSnapshot(*detail::loadPropertyTable(system_properties_file, streaming_parse_default_threshold),
+                              snapshot_file);
+    }
+} // namespace controller
+} // namespace fep3
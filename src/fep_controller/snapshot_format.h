@@ -0,0 +1,174 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include "property_table.h"
+#include "system_description.h"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /*
+     * Layout of a snapshot file (all numbers in host byte order, every part 8 byte aligned):
+     *
+     *   SnapshotHeader
+     *   SystemRecord, ParticipantRecord[participant count]                  (system description)
+     *   PropertyTableRecord, PropertyRecord[property count],
+     *   ElementRecord[element count]                                        (system properties)
+     *   string pool, every distinct string once, not terminated
+     *
+     * The properties are stored in the order timing properties, system properties,
+     * then the properties of the element instances one after another.
+     * The checksum covers everything behind the header.
+     */
+
+    /// the current version of the snapshot format, a different version is not loaded
+    constexpr uint32_t snapshot_version = 1;
+    /// identifies the byte order the snapshot was written in
+    constexpr uint32_t snapshot_byte_order_mark = 0x01020304;
+    /// "FEP3SNAP"
+    constexpr char snapshot_magic[8] = { 'F', 'E', 'P', '3', 'S', 'N', 'A', 'P' };
+
+    /// what a snapshot contains
+    enum class SnapshotContent : uint32_t
+    {
+        system_description = 1,
+        system_properties = 2
+    };
+
+    struct SnapshotHeader
+    {
+        char _magic[8];
+        uint32_t _version;
+        SnapshotContent _content;
+        uint32_t _byte_order_mark;
+        uint32_t _reserved;
+        uint64_t _file_size;
+        uint64_t _checksum;
+        uint64_t _string_pool_offset;
+        uint64_t _string_pool_size;
+    };
+
+    /// a string within the string pool
+    struct SnapshotString
+    {
+        uint32_t _offset;
+        uint32_t _length;
+    };
+
+    struct SystemRecord
+    {
+        SnapshotString _name;
+        uint32_t _participant_count;
+        uint32_t _reserved;
+    };
+
+    struct ParticipantRecord
+    {
+        /// flags of the valid file references
+        enum : uint32_t
+        {
+            timing_valid = 1,
+            input_mapping_valid = 2,
+            output_mapping_valid = 4
+        };
+
+        SnapshotString _name;
+        int32_t _init_priority;
+        int32_t _start_priority;
+        uint32_t _flags;
+        uint32_t _reserved;
+        SnapshotString _timing;
+        SnapshotString _input_mapping;
+        SnapshotString _output_mapping;
+    };
+
+    struct PropertyTableRecord
+    {
+        uint32_t _timing_property_count;
+        uint32_t _system_property_count;
+        uint32_t _element_count;
+        uint32_t _property_count;
+    };
+
+    struct PropertyRecord
+    {
+        SnapshotString _name;
+        SnapshotString _type;
+        SnapshotString _value;
+    };
+
+    struct ElementRecord
+    {
+        SnapshotString _id;
+        uint32_t _first_property;
+        uint32_t _property_count;
+    };
+
+    static_assert(sizeof(SnapshotHeader) == 56, "unexpected padding within SnapshotHeader");
+    static_assert(sizeof(SystemRecord) == 16, "unexpected padding within SystemRecord");
+    static_assert(sizeof(ParticipantRecord) == 48, "unexpected padding within ParticipantRecord");
+    static_assert(sizeof(PropertyTableRecord) == 16, "unexpected padding within PropertyTableRecord");
+    static_assert(sizeof(PropertyRecord) == 24, "unexpected padding within PropertyRecord");
+    static_assert(sizeof(ElementRecord) == 16, "unexpected padding within ElementRecord");
+    static_assert(std::is_standard_layout<ParticipantRecord>::value, "records are read in place");
+
+    /**
+     * @return true if @p file_path has the extension of a snapshot file
+     */
+    bool isSnapshotFile(const std::string& file_path);
+
+    /**
+     * Writes @p system_description as snapshot to @p snapshot_file
+     *
+     * @throws std::runtime_error if the file can not be written
+     */
+    void writeSnapshot(const SystemDescription& system_description, const std::string& snapshot_file);
+
+    /**
+     * Writes @p property_table as snapshot to @p snapshot_file
+     *
+     * @throws std::runtime_error if the file can not be written
+     */
+    void writeSnapshot(const PropertyTable& property_table, const std::string& snapshot_file);
+
+    /**
+     * Loads the system description from the snapshot @p snapshot_file
+     *
+     * @throws std::runtime_error if the file can not be read, is no valid snapshot
+     *                            or does not contain a system description
+     */
+    SystemDescription readSystemDescriptionSnapshot(const std::string& snapshot_file);
+
+    /**
+     * Loads the system properties from the snapshot @p snapshot_file
+     *
+     * @throws std::runtime_error if the file can not be read, is no valid snapshot
+     *                            or does not contain system properties
+     */
+    PropertyTable readPropertyTableSnapshot(const std::string& snapshot_file);
+} // namespace detail
+} // namespace controller
+} // namespace fep3
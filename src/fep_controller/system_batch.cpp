@@ -0,0 +1,146 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "fep_controller/system_batch.h"
+
+#include "controller_steps.h"
+#include "description_loader.h"
+#include "fep_system_access.h"
+#include "parallel_for.h"
+#include "parse_cache.h"
+#include "trace_scope.h"
+#include "worker_pool.h"
+
+#include <future>
+#include <map>
+#include <mutex>
+
+namespace fep3
+{
+namespace controller
+{
+namespace
+{
+    template <typename Content>
+    using SharedContent = std::shared_future<std::shared_ptr<const Content>>;
+
+    /**
+     * @return the parse of @p file_path, started if it is not within @p contents yet
+     */
+    template <typename Content, typename Load>
+    SharedContent<Content> findOrLoad(std::map<std::string, SharedContent<Content>>& contents,
+                                      const std::string& file_path,
+                                      Load load)
+    {
+        std::string key = file_path;
+        try
+        {
+            key = detail::getCanonicalPath(file_path);
+        }
+        catch (const std::exception&)
+        {
+            //the load reports the missing file
+        }
+        auto found = contents.find(key);
+        if (found == contents.end())
+        {
+            found = contents.emplace(key, std::async(std::launch::async, [file_path, load]()
+                {
+                    return load(file_path);
+                }).share()).first;
+        }
+        return found->second;
+    }
+}
+
+std::vector<SystemJobResult> bringUpSystems(const std::vector<SystemJob>& jobs, const BatchOptions& options)
+{
+    detail::TraceScope trace("bringUpSystems");
+    std::vector<SystemJobResult> results(jobs.size());
+
+    //every distinct file is parsed once, all of them in parallel
+    std::map<std::string, SharedContent<detail::SystemDescription>> system_descriptions;
+    std::map<std::string, SharedContent<detail::PropertyTable>> property_tables;
+    std::vector<SharedContent<detail::SystemDescription>> job_system_descriptions;
+    std::vector<SharedContent<detail::PropertyTable>> job_property_tables;
+    for (const auto& job : jobs)
+    {
+        job_system_descriptions.push_back(findOrLoad(system_descriptions, job._system_sdk_description_file,
+            [](const std::string& file_path)
+            {
+                return detail::loadSystemDescription(file_path);
+            }));
+        const auto streaming_parse_threshold = options._configure_options._streaming_parse_threshold;
+        job_property_tables.push_back(findOrLoad(property_tables, job._system_properties_file,
+            [streaming_parse_threshold](const std::string& file_path)
+            {
+                return detail::loadPropertyTable(file_path, streaming_parse_threshold);
+            }));
+    }
+
+    detail::WorkerPool worker_pool(options._worker_count);
+    std::mutex callback_mutex;
+    auto run_job = [&](size_t index)
+    {
+        const auto& job = jobs[index];
+        auto& result = results[index];
+        result._job_index = index;
+        try
+        {
+            detail::TraceScope trace_job("bringUpSystem", std::string(), job._system_sdk_description_file);
+            ConfigureOptions configure_options = options._configure_options;
+            configure_options._load_participants = true;
+            configure_options._progress_callback = nullptr;
+            configure_options._applied_properties = nullptr;
+            configure_options._plan = nullptr;
+            configure_options._retry_report = nullptr;
+            configure_options._report = options._collect_failures ? &result._report : nullptr;
+            const detail::OperationDeadline operation_deadline(configure_options._deadlines._operation_deadline);
+            detail::ProgressReporter progress(configure_options._progress_callback,
+                                              configure_options._cancellation_token);
+
+            ResolvedPaths resolved_paths;
+            auto system = std::make_unique<fep3::System>(detail::createSystem(*job_system_descriptions[index].get(),
+                                                                              job._system_sdk_description_file,
+                                                                              resolved_paths,
+                                                                              progress));
+            const auto property_table = job_property_tables[index].get();
+            {
+                detail::FepSystemAccess system_access(*system, configure_options._batch_writer_factory);
+                detail::configureSystemProperties(system_access, *property_table, configure_options,
+                                                  progress, operation_deadline, &worker_pool);
+            }
+            result._system = std::move(system);
+        }
+        catch (const std::exception& err)
+        {
+            result._error_message = err.what();
+        }
+        if (options._result_callback)
+        {
+            std::lock_guard<std::mutex> lock(callback_mutex);
+            options._result_callback(result);
+        }
+    };
+
+    //the participant work of all jobs runs on the pool, the jobs connect and wait for it
+    //on threads of their own, the pool workers must not wait for the pool
+    detail::parallelFor(jobs.size(), options._job_count, run_job);
+    return results;
+}
+} // namespace controller
+} // namespace fep3
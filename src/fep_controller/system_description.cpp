@@ -0,0 +1,74 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "system_description.h"
+
+using namespace fep::metamodel;
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    SystemDescription makeSystemDescription(FepSystem&& system_sdk_file)
+    {
+        SystemDescription system_description;
+        system_description._name = std::move(system_sdk_file._name);
+        system_description._participants.reserve(system_sdk_file._participants.size());
+        for (FepParticipant& participant : system_sdk_file._participants)
+        {
+            ParticipantDescription participant_description;
+            participant_description._name = std::move(participant._element_instance._id);
+            participant_description._init_priority = participant._init_priority;
+            participant_description._start_priority = participant._start_priority;
+            if (participant._element_instance._timing)
+            {
+                participant_description._timing._valid = true;
+                participant_description._timing._file_reference = participant._element_instance._timing->_file_reference;
+            }
+            if (participant._element_instance._input_mapping)
+            {
+                participant_description._input_mapping._valid = true;
+                participant_description._input_mapping._file_reference = participant._element_instance._input_mapping->_file_reference;
+            }
+            if (participant._element_instance._output_mapping)
+            {
+                participant_description._output_mapping._valid = true;
+                participant_description._output_mapping._file_reference = participant._element_instance._output_mapping->_file_reference;
+            }
+            system_description._participants.push_back(std::move(participant_description));
+        }
+        return system_description;
+    }
+
+    size_t estimateMemoryUsage(const SystemDescription& system_description)
+    {
+        size_t bytes = sizeof(SystemDescription) + system_description._name.capacity();
+        for (const auto& participant : system_description._participants)
+        {
+            bytes += sizeof(ParticipantDescription)
+                + participant._name.capacity()
+                + participant._timing._file_reference.capacity()
+                + participant._input_mapping._file_reference.capacity()
+                + participant._output_mapping._file_reference.capacity();
+        }
+        return bytes;
+    }
+} // namespace detail
+} // namespace controller
+} // namespace fep3
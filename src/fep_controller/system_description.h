@@ -0,0 +1,75 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_metamodel/fep_system.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * A file reference of a participant as written within the system description (not normalized)
+     */
+    struct FileReference
+    {
+        /// false if the reference is not given within the description
+        bool _valid = false;
+        std::string _file_reference;
+    };
+
+    /**
+     * The part of a participant description the controller needs to connect a system
+     */
+    struct ParticipantDescription
+    {
+        std::string _name;
+        int32_t _init_priority = 0;
+        int32_t _start_priority = 0;
+        FileReference _timing;
+        FileReference _input_mapping;
+        FileReference _output_mapping;
+    };
+
+    /**
+     * The content of a system sdk description as used by the controller
+     */
+    struct SystemDescription
+    {
+        std::string _name;
+        std::vector<ParticipantDescription> _participants;
+    };
+
+    /**
+     * Moves the content of a parsed system sdk description into a system description.
+     */
+    SystemDescription makeSystemDescription(fep::metamodel::FepSystem&& system_sdk_file);
+
+    /**
+     * @return the estimated heap and object memory used by @p system_description in bytes
+     */
+    size_t estimateMemoryUsage(const SystemDescription& system_description);
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,105 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/tracing.h>
+
+#include <atomic>
+#include <string>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /// true while a trace sink is set
+    extern std::atomic<bool> tracing_enabled;
+
+    inline bool isTracingEnabled()
+    {
+        return tracing_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// passes @p span to the current sink (if there still is one)
+    void finishSpan(TraceSpan& span);
+
+    /**
+     * Measures the phase from construction to destruction.
+     * Without a trace sink nothing but the flag is read, the strings are not even copied.
+     */
+    class TraceScope
+    {
+    public:
+        explicit TraceScope(const char* name)
+            : _active(isTracingEnabled())
+        {
+            if (_active)
+            {
+                start(name);
+            }
+        }
+
+        TraceScope(const char* name, const std::string& participant_name)
+            : _active(isTracingEnabled())
+        {
+            if (_active)
+            {
+                _span._participant_name = participant_name;
+                start(name);
+            }
+        }
+
+        TraceScope(const char* name, const std::string& participant_name, const std::string& detail)
+            : _active(isTracingEnabled())
+        {
+            if (_active)
+            {
+                _span._participant_name = participant_name;
+                _span._detail = detail;
+                start(name);
+            }
+        }
+
+        ~TraceScope()
+        {
+            if (_active)
+            {
+                _span._end = std::chrono::steady_clock::now();
+                finishSpan(_span);
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        void start(const char* name)
+        {
+            _span._name = name;
+            _span._thread_id = std::this_thread::get_id();
+            _span._begin = std::chrono::steady_clock::now();
+        }
+
+    private:
+        const bool _active;
+        TraceSpan _span;
+    };
+} // namespace detail
+} // namespace controller
+} // namespace fep3
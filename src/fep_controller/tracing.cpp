@@ -0,0 +1,179 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "trace_scope.h"
+
+#include <a_util/strings.h>
+
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    std::atomic<bool> tracing_enabled(false);
+
+    namespace
+    {
+        std::shared_ptr<ITraceSink> trace_sink;
+    }
+
+    void finishSpan(TraceSpan& span)
+    {
+        //the sink might have been removed while the phase was running
+        auto sink = std::atomic_load(&trace_sink);
+        if (sink)
+        {
+            sink->onSpan(span);
+        }
+    }
+
+    struct ChromeTraceData
+    {
+        std::chrono::steady_clock::time_point _origin = std::chrono::steady_clock::now();
+        mutable std::mutex _mutex;
+        std::vector<TraceSpan> _spans;
+        std::unordered_map<std::thread::id, size_t> _thread_numbers;
+        std::vector<size_t> _span_thread_numbers;
+    };
+
+    namespace
+    {
+        void writeJsonString(std::ostream& stream, const std::string& text)
+        {
+            stream << '"';
+            for (const auto character : text)
+            {
+                switch (character)
+                {
+                case '"': stream << "\\\""; break;
+                case '\\': stream << "\\\\"; break;
+                case '\n': stream << "\\n"; break;
+                case '\r': stream << "\\r"; break;
+                case '\t': stream << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(character) < 0x20)
+                    {
+                        stream << a_util::strings::format("\\u%04x", static_cast<unsigned int>(character));
+                    }
+                    else
+                    {
+                        stream << character;
+                    }
+                    break;
+                }
+            }
+            stream << '"';
+        }
+
+        double toMicroseconds(std::chrono::steady_clock::duration duration)
+        {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        }
+    }
+} // namespace detail
+
+void setTraceSink(std::shared_ptr<ITraceSink> sink)
+{
+    const bool enabled = static_cast<bool>(sink);
+    std::atomic_store(&detail::trace_sink, std::move(sink));
+    detail::tracing_enabled.store(enabled);
+}
+
+std::shared_ptr<ITraceSink> getTraceSink()
+{
+    return std::atomic_load(&detail::trace_sink);
+}
+
+ChromeTraceWriter::ChromeTraceWriter()
+    : _data(new detail::ChromeTraceData())
+{
+}
+
+ChromeTraceWriter::~ChromeTraceWriter() = default;
+
+void ChromeTraceWriter::onSpan(const TraceSpan& span)
+{
+    std::lock_guard<std::mutex> lock(_data->_mutex);
+    //chrome shows small thread numbers more readable than the native ids
+    const auto thread_number = _data->_thread_numbers.emplace(span._thread_id,
+                                                              _data->_thread_numbers.size() + 1).first->second;
+    _data->_spans.push_back(span);
+    _data->_span_thread_numbers.push_back(thread_number);
+}
+
+void ChromeTraceWriter::write(std::ostream& stream) const
+{
+    std::lock_guard<std::mutex> lock(_data->_mutex);
+    stream << "{\"traceEvents\":[";
+    for (size_t index = 0; index < _data->_spans.size(); ++index)
+    {
+        const auto& span = _data->_spans[index];
+        stream << (index == 0 ? "\n" : ",\n");
+        stream << "{\"name\":";
+        detail::writeJsonString(stream, span._name);
+        stream << ",\"cat\":\"fep_controller\",\"ph\":\"X\""
+               << a_util::strings::format(",\"ts\":%.3f,\"dur\":%.3f",
+                                          detail::toMicroseconds(span._begin - _data->_origin),
+                                          detail::toMicroseconds(span._end - span._begin))
+               << ",\"pid\":1,\"tid\":" << _data->_span_thread_numbers[index]
+               << ",\"args\":{\"participant\":";
+        detail::writeJsonString(stream, span._participant_name);
+        stream << ",\"detail\":";
+        detail::writeJsonString(stream, span._detail);
+        stream << "}}";
+    }
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void ChromeTraceWriter::writeToFile(const std::string& file_path) const
+{
+    std::ofstream file_stream(file_path, std::ios::out | std::ios::trunc);
+    if (!file_stream.is_open())
+    {
+        throw std::runtime_error(a_util::strings::format("unable to open the trace file '%s'",
+            file_path.c_str()));
+    }
+    write(file_stream);
+    file_stream.close();
+    if (file_stream.fail())
+    {
+        throw std::runtime_error(a_util::strings::format("unable to write the trace file '%s'",
+            file_path.c_str()));
+    }
+}
+
+size_t ChromeTraceWriter::getSpanCount() const
+{
+    std::lock_guard<std::mutex> lock(_data->_mutex);
+    return _data->_spans.size();
+}
+
+void ChromeTraceWriter::clear()
+{
+    std::lock_guard<std::mutex> lock(_data->_mutex);
+    _data->_spans.clear();
+    _data->_span_thread_numbers.clear();
+}
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,80 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "worker_pool.h"
+
+#include <algorithm>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    WorkerPool::WorkerPool(size_t thread_count)
+    {
+        thread_count = std::max<size_t>(thread_count, 1);
+        _threads.reserve(thread_count);
+        for (size_t index = 0; index < thread_count; ++index)
+        {
+            _threads.emplace_back([this]() { run(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _task_posted.notify_all();
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    void WorkerPool::post(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push_back(std::move(task));
+        }
+        _task_posted.notify_one();
+    }
+
+    void WorkerPool::run()
+    {
+        for (;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _task_posted.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                if (_tasks.empty())
+                {
+                    return;
+                }
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+        }
+    }
+} // namespace detail
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,69 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * A fixed number of threads running posted tasks in the order they were posted.
+     * Shared by the configurations of several systems, it bounds the participant requests
+     * running at the same time.
+     * The tasks must not wait for other tasks of the pool.
+     */
+    class WorkerPool
+    {
+    public:
+        /**
+         * @param [in] thread_count the number of threads (at least one is started)
+         */
+        explicit WorkerPool(size_t thread_count);
+        /// runs the tasks already posted and joins the threads
+        ~WorkerPool();
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        /**
+         * Runs @p task on one of the threads, the task must not throw
+         */
+        void post(std::function<void()> task);
+
+    private:
+        void run();
+
+    private:
+        std::mutex _mutex;
+        std::condition_variable _task_posted;
+        std::deque<std::function<void()>> _tasks;
+        bool _stopping = false;
+        std::vector<std::thread> _threads;
+    };
+} // namespace detail
+} // namespace controller
+} // namespace fep3
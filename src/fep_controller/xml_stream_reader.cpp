@@ -0,0 +1,442 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "xml_stream_reader.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    namespace
+    {
+        constexpr int end_of_stream = std::char_traits<char>::eof();
+        //character data is handed to the handler in parts of this size at most
+        constexpr size_t text_flush_size = 64 * 1024;
+
+        bool isWhitespace(int c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        bool isNameDelimiter(int c)
+        {
+            return c == end_of_stream || isWhitespace(c) || c == '/' || c == '>' || c == '=' || c == '<';
+        }
+
+        void appendUtf8(std::string& text, uint32_t code_point)
+        {
+            if (code_point < 0x80)
+            {
+                text.push_back(static_cast<char>(code_point));
+            }
+            else if (code_point < 0x800)
+            {
+                text.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+                text.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            }
+            else if (code_point < 0x10000)
+            {
+                text.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+                text.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+                text.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            }
+            else
+            {
+                text.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+                text.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+                text.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+                text.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            }
+        }
+
+        /// decodes the reference @p reference (without '&' and ';'), false if it is unknown
+        bool decodeReference(const std::string& reference, std::string& text)
+        {
+            if (reference == "lt") { text.push_back('<'); return true; }
+            if (reference == "gt") { text.push_back('>'); return true; }
+            if (reference == "amp") { text.push_back('&'); return true; }
+            if (reference == "quot") { text.push_back('"'); return true; }
+            if (reference == "apos") { text.push_back('\''); return true; }
+            if (reference.size() > 1 && reference[0] == '#')
+            {
+                const bool hex = reference[1] == 'x';
+                const std::string digits = reference.substr(hex ? 2 : 1);
+                if (digits.empty())
+                {
+                    return false;
+                }
+                char* end = nullptr;
+                const unsigned long code_point = std::strtoul(digits.c_str(), &end, hex ? 16 : 10);
+                if (*end != '\0' || code_point > 0x10FFFF)
+                {
+                    return false;
+                }
+                appendUtf8(text, static_cast<uint32_t>(code_point));
+                return true;
+            }
+            return false;
+        }
+    }
+
+    XmlStreamReader::XmlStreamReader(std::streambuf& input)
+        : _input(input)
+    {
+    }
+
+    const std::string& XmlStreamReader::getLastError() const
+    {
+        return _last_error;
+    }
+
+    bool XmlStreamReader::setError(const char* description)
+    {
+        _last_error = description;
+        return false;
+    }
+
+    int XmlStreamReader::get()
+    {
+        return _input.sbumpc();
+    }
+
+    int XmlStreamReader::peek()
+    {
+        return _input.sgetc();
+    }
+
+    bool XmlStreamReader::consume(const char* literal)
+    {
+        //only used for literals which can be decided by their first character after a '<!'
+        for (; *literal != '\0'; ++literal)
+        {
+            if (peek() != static_cast<unsigned char>(*literal))
+            {
+                return false;
+            }
+            get();
+        }
+        return true;
+    }
+
+    bool XmlStreamReader::skipUntil(const char* terminator)
+    {
+        const std::string end(terminator);
+        std::string window;
+        for (int c = get(); c != end_of_stream; c = get())
+        {
+            window.push_back(static_cast<char>(c));
+            if (window.size() > end.size())
+            {
+                window.erase(0, 1);
+            }
+            if (window == end)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void XmlStreamReader::skipWhitespace()
+    {
+        while (isWhitespace(peek()))
+        {
+            get();
+        }
+    }
+
+    std::string XmlStreamReader::readName()
+    {
+        std::string name;
+        while (!isNameDelimiter(peek()))
+        {
+            name.push_back(static_cast<char>(get()));
+        }
+        return name;
+    }
+
+    bool XmlStreamReader::readText(IXmlStreamHandler& handler)
+    {
+        _text.clear();
+        bool only_whitespace = true;
+        for (int c = peek(); c != end_of_stream && c != '<'; c = peek())
+        {
+            get();
+            if (c == '&')
+            {
+                std::string reference;
+                while (peek() != ';' && peek() != '<' && peek() != end_of_stream && reference.size() < 16)
+                {
+                    reference.push_back(static_cast<char>(get()));
+                }
+                if (peek() == ';' && decodeReference(reference, _text))
+                {
+                    get();
+                }
+                else
+                {
+                    //unknown references are kept as they are
+                    _text.push_back('&');
+                    _text.append(reference);
+                }
+                only_whitespace = false;
+                continue;
+            }
+            if (c == '\r')
+            {
+                //end of line normalization
+                if (peek() == '\n')
+                {
+                    get();
+                }
+                c = '\n';
+            }
+            only_whitespace = only_whitespace && isWhitespace(c);
+            _text.push_back(static_cast<char>(c));
+            if (!only_whitespace && _text.size() >= text_flush_size && !_open_elements.empty())
+            {
+                handler.onText(_text);
+                _text.clear();
+            }
+        }
+
+        if (_open_elements.empty())
+        {
+            if (!only_whitespace)
+            {
+                return setError(_root_found ? "Error parsing PCDATA section" : "No document element found");
+            }
+            return true;
+        }
+        //whitespace-only PCDATA is dropped like the DOM based parser does
+        if (!only_whitespace)
+        {
+            handler.onText(_text);
+        }
+        return true;
+    }
+
+    bool XmlStreamReader::readCData(IXmlStreamHandler& handler)
+    {
+        _text.clear();
+        for (int c = get(); c != end_of_stream; c = get())
+        {
+            _text.push_back(static_cast<char>(c));
+            const size_t size = _text.size();
+            if (size >= 3 && _text[size - 1] == '>' && _text[size - 2] == ']' && _text[size - 3] == ']')
+            {
+                _text.resize(size - 3);
+                if (_open_elements.empty())
+                {
+                    return setError("Error parsing CDATA section");
+                }
+                handler.onText(_text);
+                return true;
+            }
+        }
+        return setError("Error parsing CDATA section");
+    }
+
+    bool XmlStreamReader::skipDocType()
+    {
+        size_t bracket_depth = 0;
+        for (int c = get(); c != end_of_stream; c = get())
+        {
+            if (c == '[')
+            {
+                ++bracket_depth;
+            }
+            else if (c == ']' && bracket_depth > 0)
+            {
+                --bracket_depth;
+            }
+            else if (c == '>' && bracket_depth == 0)
+            {
+                return true;
+            }
+        }
+        return setError("Error parsing document type declaration");
+    }
+
+    bool XmlStreamReader::readStartElement(IXmlStreamHandler& handler)
+    {
+        const std::string name = readName();
+        if (name.empty())
+        {
+            return setError("Could not determine tag type");
+        }
+        _root_found = true;
+        _open_elements.push_back(name);
+        handler.onStartElement(name);
+
+        while (true)
+        {
+            skipWhitespace();
+            const int c = get();
+            if (c == '>')
+            {
+                return true;
+            }
+            if (c == '/')
+            {
+                if (get() != '>')
+                {
+                    return setError("Error parsing start element tag");
+                }
+                _open_elements.pop_back();
+                handler.onEndElement(name);
+                return true;
+            }
+            if (c == end_of_stream)
+            {
+                return setError("Error parsing start element tag");
+            }
+
+            //attributes are not needed by the controller, they are only checked and skipped
+            if (isNameDelimiter(c))
+            {
+                return setError("Error parsing element attribute");
+            }
+            readName();
+            skipWhitespace();
+            if (get() != '=')
+            {
+                return setError("Error parsing element attribute");
+            }
+            skipWhitespace();
+            const int quote = get();
+            if (quote != '"' && quote != '\'')
+            {
+                return setError("Error parsing element attribute");
+            }
+            int value_char = get();
+            while (value_char != quote && value_char != end_of_stream)
+            {
+                value_char = get();
+            }
+            if (value_char == end_of_stream)
+            {
+                return setError("Error parsing element attribute");
+            }
+        }
+    }
+
+    bool XmlStreamReader::readEndElement(IXmlStreamHandler& handler)
+    {
+        const std::string name = readName();
+        skipWhitespace();
+        if (get() != '>')
+        {
+            return setError("Error parsing end element tag");
+        }
+        if (_open_elements.empty() || _open_elements.back() != name)
+        {
+            return setError("Start-end tags mismatch");
+        }
+        _open_elements.pop_back();
+        handler.onEndElement(name);
+        return true;
+    }
+
+    bool XmlStreamReader::read(IXmlStreamHandler& handler)
+    {
+        _open_elements.clear();
+        _root_found = false;
+        _last_error.clear();
+
+        //skip an UTF-8 byte order mark
+        if (peek() == 0xEF)
+        {
+            get();
+            if (get() != 0xBB || get() != 0xBF)
+            {
+                return setError("No document element found");
+            }
+        }
+
+        while (peek() != end_of_stream)
+        {
+            if (peek() != '<')
+            {
+                if (!readText(handler))
+                {
+                    return false;
+                }
+                continue;
+            }
+            get();
+
+            const int c = peek();
+            bool success = true;
+            if (c == '?')
+            {
+                success = skipUntil("?>") || setError("Error parsing document declaration/processing instruction");
+            }
+            else if (c == '!')
+            {
+                get();
+                if (peek() == '-')
+                {
+                    success = (consume("--") && skipUntil("-->")) || setError("Error parsing comment");
+                }
+                else if (peek() == '[')
+                {
+                    success = consume("[CDATA[") ? readCData(handler) : setError("Error parsing CDATA section");
+                }
+                else if (peek() == 'D')
+                {
+                    success = consume("DOCTYPE") ? skipDocType() : setError("Error parsing document type declaration");
+                }
+                else
+                {
+                    success = setError("Could not determine tag type");
+                }
+            }
+            else if (c == '/')
+            {
+                get();
+                success = readEndElement(handler);
+            }
+            else
+            {
+                success = readStartElement(handler);
+            }
+
+            if (!success)
+            {
+                return false;
+            }
+        }
+
+        if (!_open_elements.empty())
+        {
+            return setError("Start-end tags mismatch");
+        }
+        if (!_root_found)
+        {
+            return setError("No document element found");
+        }
+        return true;
+    }
+} // namespace detail
+} // namespace controller
+} // namespace fep3
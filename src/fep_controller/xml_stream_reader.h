@@ -0,0 +1,90 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+namespace detail
+{
+    /**
+     * Receives the events of a @ref XmlStreamReader
+     */
+    class IXmlStreamHandler
+    {
+    public:
+        virtual ~IXmlStreamHandler() = default;
+        /// called for every start tag with the element name (including a namespace prefix)
+        virtual void onStartElement(const std::string& name) = 0;
+        /// called for every end tag (and after the start tag of an empty element)
+        virtual void onEndElement(const std::string& name) = 0;
+        /// called for character data (decoded text and CDATA) of the current element, possibly in several parts,
+        /// text consisting of whitespace only is dropped like in the DOM
+        virtual void onText(const std::string& text) = 0;
+    };
+
+    /**
+     * Minimal non validating XML pull parser, reading from a stream buffer without building a DOM.
+     * Supports elements, attributes (skipped), character data, CDATA sections, the predefined and
+     * numeric character references, comments, processing instructions and document type declarations (skipped).
+     * Error descriptions are the ones of the pugixml parser used by a_util::xml::DOM.
+     */
+    class XmlStreamReader
+    {
+    public:
+        explicit XmlStreamReader(std::streambuf& input);
+
+        /**
+         * Reads the whole input and reports the events to @p handler.
+         *
+         * @return false if the input is not well formed, see @ref getLastError
+         */
+        bool read(IXmlStreamHandler& handler);
+
+        /// @return the description of the last error
+        const std::string& getLastError() const;
+
+    private:
+        int get();
+        int peek();
+        bool consume(const char* literal);
+        bool skipUntil(const char* terminator);
+        void skipWhitespace();
+        std::string readName();
+        bool readText(IXmlStreamHandler& handler);
+        bool readCData(IXmlStreamHandler& handler);
+        bool readStartElement(IXmlStreamHandler& handler);
+        bool readEndElement(IXmlStreamHandler& handler);
+        bool skipDocType();
+        bool setError(const char* description);
+
+    private:
+        std::streambuf& _input;
+        std::vector<std::string> _open_elements;
+        bool _root_found = false;
+        std::string _text;
+        std::string _last_error;
+    };
+} // namespace detail
+} // namespace controller
+} // namespace fep3
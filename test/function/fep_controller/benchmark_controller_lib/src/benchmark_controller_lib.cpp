@@ -0,0 +1,503 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+
+/*
+ * Benchmarks of the connect and configure pipeline of the controller library.
+ * The phases are measured separately on systems of N participants with M properties each
+ * written by the system generator:
+ *  - xml load and metamodel parse of the description files
+ *  - normalization of the file references of the participants
+ *  - adding the participants to the system
+ *  - the transition to the loaded state
+ *  - pushing the properties and configuring the timing
+ * The phases which need running participants use a smaller N than the pure controller side phases.
+ * The whole configuration is additionally measured on in-process loopback participants with a simulated
+ * RPC latency, which allows thousands of participants and reproducible numbers.
+ */
+
+#include <benchmark/benchmark.h>
+#include <fep_controller/fep_controller.h>
+#include <fep_system/fep_system.h>
+#include <fep_metamodel/fep_system.h>
+#include <a_util/filesystem.h>
+#include <a_util/strings.h>
+#include <a_util/xml.h>
+
+#include <fep3/core.h>
+#include <fep3/core/participant_executor.hpp>
+#include <fep3/components/configuration/propertynode.h>
+
+#include "loopback_system.h"
+#include "path_normalization.h"
+#include "system_generator.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::string benchmark_system_name = "FEP_SYSTEM_BENCHMARK";
+
+    /// options of the system the benchmark elements register their properties for
+    fep3::controller::test::SystemGeneratorOptions benchmark_element_options;
+
+    /**
+     * Options of a system of @p participant_count participants with @p property_count int properties each,
+     * every participant refers to timing and mapping files shared with other participants
+     */
+    fep3::controller::test::SystemGeneratorOptions makeGeneratorOptions(int64_t participant_count,
+                                                                         int64_t property_count,
+                                                                         const std::string& timing_configuration_type)
+    {
+        fep3::controller::test::SystemGeneratorOptions options;
+        options._system_name = benchmark_system_name;
+        options._participant_count = static_cast<size_t>(participant_count);
+        options._property_count = static_cast<size_t>(property_count);
+        options._system_property_count = 0;
+        options._property_type_mix = { 1, 1, 1, 1 };
+        options._property_node = "benchmark";
+        options._timing_configuration_type = timing_configuration_type;
+        options._timing_file_count = 4;
+        options._mapping_file_count = 4;
+        return options;
+    }
+
+    fep3::controller::test::GeneratedSystemFiles generateFiles(
+        const fep3::controller::test::SystemGeneratorOptions& options)
+    {
+        a_util::filesystem::createDirectory(BENCHMARK_FILES_DIR);
+        const auto base_name = "benchmark_" + a_util::strings::toString(static_cast<uint64_t>(options._participant_count))
+            + "_" + a_util::strings::toString(static_cast<uint64_t>(options._property_count))
+            + "_" + options._timing_configuration_type;
+        return fep3::controller::test::generateSystemFiles(options, BENCHMARK_FILES_DIR, base_name);
+    }
+
+    std::string writeSystemDescription(int64_t participant_count)
+    {
+        return generateFiles(makeGeneratorOptions(participant_count, 0, "PropertyBased"))._system_description_file;
+    }
+
+    std::string writeSystemProperties(int64_t participant_count,
+                                      int64_t property_count,
+                                      const std::string& timing_configuration_type)
+    {
+        return generateFiles(makeGeneratorOptions(participant_count, property_count, timing_configuration_type))
+            ._system_properties_file;
+    }
+
+    std::vector<std::string> getParticipantNames(int64_t participant_count)
+    {
+        std::vector<std::string> participant_names;
+        for (int64_t index = 0; index < participant_count; ++index)
+        {
+            participant_names.push_back(fep3::controller::test::getGeneratedParticipantName(static_cast<size_t>(index)));
+        }
+        return participant_names;
+    }
+
+    std::shared_ptr<fep3::NativePropertyNode> makePropertyNode(const std::string& name, const std::string& type)
+    {
+        if (type == "int")
+        {
+            return fep3::makeNativePropertyNode<int32_t>(name, 0);
+        }
+        else if (type == "double")
+        {
+            return fep3::makeNativePropertyNode<double>(name, 0.0);
+        }
+        else if (type == "bool")
+        {
+            return fep3::makeNativePropertyNode<bool>(name, false);
+        }
+        return fep3::makeNativePropertyNode<std::string>(name, "");
+    }
+
+    /**
+     * Registers the properties generated for @ref benchmark_element_options
+     */
+    struct BenchmarkElement : public fep3::core::ElementBase
+    {
+        BenchmarkElement()
+            : fep3::core::ElementBase("Benchmarkelement", "3.0")
+        {
+        }
+
+        fep3::Result load() override
+        {
+            auto config_service = getComponents()->getComponent<fep3::IConfigurationService>();
+            if (config_service)
+            {
+                auto benchmark_node = std::make_shared<fep3::NativePropertyNode>(
+                    benchmark_element_options._property_node, "", "node");
+                const auto node_prefix_length = benchmark_element_options._property_node.size() + 1;
+                for (const auto& property : fep3::controller::test::getGeneratedProperties(benchmark_element_options))
+                {
+                    benchmark_node->setChild(makePropertyNode(property._name.substr(node_prefix_length), property._type));
+                }
+                config_service->registerNode(benchmark_node);
+                return{};
+            }
+            RETURN_ERROR_DESCRIPTION(fep3::ERR_FAILED, "Unable to initialize benchmark element: Configuration service not reachable.");
+        }
+    };
+
+    struct PartStruct
+    {
+        PartStruct(fep3::core::Participant&& part)
+            : _part(std::move(part)), _part_executor(_part)
+        {
+        }
+        fep3::core::Participant _part;
+        fep3::core::ParticipantExecutor _part_executor;
+    };
+
+    using BenchmarkParticipants = std::map<std::string, std::unique_ptr<PartStruct>>;
+
+    BenchmarkParticipants createBenchmarkParticipants(const fep3::controller::test::SystemGeneratorOptions& options)
+    {
+        benchmark_element_options = options;
+        BenchmarkParticipants participants;
+        for (const auto& name : getParticipantNames(static_cast<int64_t>(options._participant_count)))
+        {
+            auto part = fep3::core::createParticipant<fep3::core::ElementFactory<BenchmarkElement>>(
+                name, "1.0", benchmark_system_name);
+            auto part_exec = std::make_unique<PartStruct>(std::move(part));
+            part_exec->_part_executor.exec();
+            participants[name] = std::move(part_exec);
+        }
+        return participants;
+    }
+
+    /**
+     * Records when the last participant reached a stage of the configuration
+     */
+    class StageClock
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        fep3::controller::ProgressCallback makeCallback()
+        {
+            return [this](fep3::controller::ProgressStage stage, const std::string&)
+            {
+                _reached[stage] = Clock::now();
+            };
+        }
+
+        void start()
+        {
+            _reached.clear();
+            _start = Clock::now();
+        }
+
+        /// seconds from the last report of @p from (or the start) to the last report of @p to
+        double getSeconds(fep3::controller::ProgressStage to) const
+        {
+            return std::chrono::duration<double>(_reached.at(to) - _start).count();
+        }
+
+        double getSeconds(fep3::controller::ProgressStage from, fep3::controller::ProgressStage to) const
+        {
+            return std::chrono::duration<double>(_reached.at(to) - _reached.at(from)).count();
+        }
+
+    private:
+        Clock::time_point _start;
+        std::map<fep3::controller::ProgressStage, Clock::time_point> _reached;
+    };
+
+    void setCounters(benchmark::State& state, int64_t participant_count, int64_t property_count)
+    {
+        state.counters["participants"] = static_cast<double>(participant_count);
+        state.counters["properties"] = static_cast<double>(participant_count * property_count);
+    }
+}
+
+static void BM_XmlLoadSystemDescription(benchmark::State& state)
+{
+    const auto system_file = writeSystemDescription(state.range(0));
+    for (auto _ : state)
+    {
+        a_util::xml::DOM dom;
+        if (!dom.load(system_file))
+        {
+            state.SkipWithError(dom.getLastError().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(dom);
+    }
+    setCounters(state, state.range(0), 0);
+}
+BENCHMARK(BM_XmlLoadSystemDescription)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_XmlLoadSystemProperties(benchmark::State& state)
+{
+    const auto properties_file = writeSystemProperties(state.range(0), state.range(1), "PropertyBased");
+    for (auto _ : state)
+    {
+        a_util::xml::DOM dom;
+        if (!dom.load(properties_file))
+        {
+            state.SkipWithError(dom.getLastError().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(dom);
+    }
+    setCounters(state, state.range(0), state.range(1));
+}
+BENCHMARK(BM_XmlLoadSystemProperties)->Args({ 10, 10 })->Args({ 100, 100 })->Args({ 1000, 100 })->Unit(benchmark::kMillisecond);
+
+static void BM_ParseSystemDescription(benchmark::State& state)
+{
+    const auto system_file = writeSystemDescription(state.range(0));
+    a_util::xml::DOM dom;
+    dom.load(system_file);
+    for (auto _ : state)
+    {
+        fep::metamodel::FepSystem system_description;
+        if (!system_description.internalReadConfig(dom))
+        {
+            state.SkipWithError(system_description.getLastError().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(system_description);
+    }
+    setCounters(state, state.range(0), 0);
+}
+BENCHMARK(BM_ParseSystemDescription)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_ParseSystemProperties(benchmark::State& state)
+{
+    const auto properties_file = writeSystemProperties(state.range(0), state.range(1), "PropertyBased");
+    a_util::xml::DOM dom;
+    dom.load(properties_file);
+    for (auto _ : state)
+    {
+        fep::metamodel::PropertyFile property_file;
+        if (!property_file.internalReadConfig(dom))
+        {
+            state.SkipWithError(property_file.getLastError().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(property_file);
+    }
+    setCounters(state, state.range(0), state.range(1));
+}
+BENCHMARK(BM_ParseSystemProperties)->Args({ 10, 10 })->Args({ 100, 100 })->Args({ 1000, 100 })->Unit(benchmark::kMillisecond);
+
+static void BM_NormalizePaths(benchmark::State& state)
+{
+    const auto system_file = writeSystemDescription(state.range(0));
+    a_util::xml::DOM dom;
+    dom.load(system_file);
+    fep::metamodel::FepSystem system_description;
+    system_description.internalReadConfig(dom);
+    const a_util::filesystem::Path system_file_directory = a_util::filesystem::Path(system_file).getParent();
+
+    for (auto _ : state)
+    {
+        for (const auto& participant : system_description._participants)
+        {
+            const auto& element_instance = participant._element_instance;
+            benchmark::DoNotOptimize(fep3::controller::detail::normalizeToAnotherPath(
+                element_instance._timing->_file_reference, system_file_directory));
+            benchmark::DoNotOptimize(fep3::controller::detail::normalizeToAnotherPath(
+                element_instance._input_mapping->_file_reference, system_file_directory));
+            benchmark::DoNotOptimize(fep3::controller::detail::normalizeToAnotherPath(
+                element_instance._output_mapping->_file_reference, system_file_directory));
+        }
+    }
+    setCounters(state, state.range(0), 0);
+}
+BENCHMARK(BM_NormalizePaths)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_ResolvePaths(benchmark::State& state)
+{
+    const auto system_file = writeSystemDescription(state.range(0));
+    a_util::xml::DOM dom;
+    dom.load(system_file);
+    fep::metamodel::FepSystem system_description;
+    system_description.internalReadConfig(dom);
+    const std::string system_file_directory = a_util::filesystem::Path(system_file).getParent();
+
+    for (auto _ : state)
+    {
+        // the same scope as within one connectSystem call
+        fep3::controller::ResolvedPaths resolved_paths;
+        for (const auto& participant : system_description._participants)
+        {
+            const auto& element_instance = participant._element_instance;
+            benchmark::DoNotOptimize(resolved_paths.resolve(
+                element_instance._timing->_file_reference, system_file_directory));
+            benchmark::DoNotOptimize(resolved_paths.resolve(
+                element_instance._input_mapping->_file_reference, system_file_directory));
+            benchmark::DoNotOptimize(resolved_paths.resolve(
+                element_instance._output_mapping->_file_reference, system_file_directory));
+        }
+    }
+    setCounters(state, state.range(0), 0);
+}
+BENCHMARK(BM_ResolvePaths)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_SystemAdd(benchmark::State& state)
+{
+    const auto participant_names = getParticipantNames(state.range(0));
+    for (auto _ : state)
+    {
+        fep3::System system(benchmark_system_name);
+        for (const auto& participant_name : participant_names)
+        {
+            system.add(participant_name);
+        }
+        benchmark::DoNotOptimize(system);
+    }
+    setCounters(state, state.range(0), 0);
+}
+BENCHMARK(BM_SystemAdd)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+static void BM_ConnectSystem(benchmark::State& state)
+{
+    const auto system_file = writeSystemDescription(state.range(0));
+    for (auto _ : state)
+    {
+        // measure the whole pipeline, not the description cache
+        state.PauseTiming();
+        fep3::controller::invalidateDescriptionCache();
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(fep3::controller::connectSystem(system_file));
+    }
+    setCounters(state, state.range(0), 0);
+}
+BENCHMARK(BM_ConnectSystem)->Arg(10)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Runs the configuration on running participants, @p measure picks the measured phase out of the stage clock
+ */
+template <typename MeasureFunction>
+void runConfigureSystemProperties(benchmark::State& state,
+                                  const std::string& timing_configuration_type,
+                                  MeasureFunction measure)
+{
+    const auto participant_count = state.range(0);
+    const auto property_count = state.range(1);
+    const auto generator_options = makeGeneratorOptions(participant_count, property_count, timing_configuration_type);
+    const auto files = generateFiles(generator_options);
+    auto participants = createBenchmarkParticipants(generator_options);
+    auto system = fep3::controller::connectSystem(files._system_description_file);
+
+    StageClock stage_clock;
+    fep3::controller::ConfigureOptions options;
+    options._progress_callback = stage_clock.makeCallback();
+    for (auto _ : state)
+    {
+        system.setSystemState(fep3::SystemAggregatedState::unloaded);
+        stage_clock.start();
+        fep3::controller::configureSystemProperties(system, files._system_properties_file, options);
+        state.SetIterationTime(measure(stage_clock));
+    }
+    system.shutdown();
+    setCounters(state, participant_count, property_count);
+}
+
+static void BM_StateTransitionLoaded(benchmark::State& state)
+{
+    runConfigureSystemProperties(state, "PropertyBased", [](const StageClock& stage_clock)
+    {
+        return stage_clock.getSeconds(fep3::controller::ProgressStage::parsed,
+                                      fep3::controller::ProgressStage::loaded);
+    });
+}
+BENCHMARK(BM_StateTransitionLoaded)->Args({ 1, 10 })->Args({ 4, 10 })->Args({ 16, 10 })
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
+
+static void BM_PropertyPush(benchmark::State& state)
+{
+    runConfigureSystemProperties(state, "PropertyBased", [](const StageClock& stage_clock)
+    {
+        return stage_clock.getSeconds(fep3::controller::ProgressStage::loaded,
+                                      fep3::controller::ProgressStage::configured);
+    });
+}
+BENCHMARK(BM_PropertyPush)->Args({ 1, 10 })->Args({ 4, 100 })->Args({ 16, 100 })->Args({ 16, 1000 })
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
+
+static void BM_TimingConfiguration(benchmark::State& state)
+{
+    runConfigureSystemProperties(state, "Timing3NoMaster", [](const StageClock& stage_clock)
+    {
+        return stage_clock.getSeconds(fep3::controller::ProgressStage::configured,
+                                      fep3::controller::ProgressStage::timing_applied);
+    });
+}
+BENCHMARK(BM_TimingConfiguration)->Args({ 1, 0 })->Args({ 4, 0 })->Args({ 16, 0 })
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
+
+static void BM_ConfigureSystemProperties(benchmark::State& state)
+{
+    runConfigureSystemProperties(state, "Timing3NoMaster", [](const StageClock& stage_clock)
+    {
+        return stage_clock.getSeconds(fep3::controller::ProgressStage::timing_applied);
+    });
+}
+BENCHMARK(BM_ConfigureSystemProperties)->Args({ 4, 100 })->Args({ 16, 100 })
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Arguments: participants, properties per participant, worker count, RPC latency in us, batched writes,
+ *            participants loaded one by one
+ */
+static void BM_LoopbackConfigure(benchmark::State& state)
+{
+    const auto participant_count = state.range(0);
+    const auto property_count = state.range(1);
+    const auto files = generateFiles(makeGeneratorOptions(participant_count, property_count, "Timing3NoMaster"));
+    fep3::controller::test::LoopbackBehaviour behaviour;
+    behaviour._latency = std::chrono::microseconds(state.range(3));
+    behaviour._batch_writes = state.range(4) != 0;
+    fep3::controller::ConfigureOptions options;
+    options._worker_count = static_cast<size_t>(state.range(2));
+    options._load_participants = state.range(5) != 0;
+
+    uint64_t round_trips = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        fep3::controller::test::LoopbackSystem system(benchmark_system_name, behaviour);
+        for (int64_t index = 0; index < participant_count; ++index)
+        {
+            system.add(fep3::controller::test::getGeneratedParticipantName(static_cast<size_t>(index)));
+        }
+        state.ResumeTiming();
+        fep3::controller::configureSystemProperties(system, files._system_properties_file, options);
+        round_trips = system.getStatistics()._round_trips;
+    }
+    setCounters(state, participant_count, property_count);
+    state.counters["round_trips"] = static_cast<double>(round_trips);
+}
+BENCHMARK(BM_LoopbackConfigure)
+    ->Args({ 1000, 100, 1, 0, 0, 0 })->Args({ 1000, 100, 16, 0, 0, 0 })
+    ->Args({ 100, 100, 1, 50, 0, 0 })->Args({ 100, 100, 16, 50, 0, 0 })->Args({ 100, 100, 16, 50, 1, 0 })
+    ->Args({ 100, 100, 16, 50, 0, 1 })
+    ->Args({ 5000, 10, 16, 0, 0, 0 })
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,707 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "loopback_system.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+namespace fep3
+{
+namespace controller
+{
+namespace test
+{
+    namespace
+    {
+        using State = fep3::rpc::IRPCParticipantStateMachine::State;
+
+        // the probabilities are compared to the raw engine output, which is specified for every platform
+        bool isHit(std::mt19937& engine, double rate)
+        {
+            if (rate <= 0.0)
+            {
+                return false;
+            }
+            return static_cast<double>(engine()) < rate * 4294967296.0;
+        }
+
+        std::string toPropertyPath(const std::string& node_path, const std::string& name)
+        {
+            std::string path = node_path;
+            while (!path.empty() && path.front() == '/')
+            {
+                path.erase(0, 1);
+            }
+            const auto name_begin = name.find_first_not_of('/');
+            if (name_begin == std::string::npos)
+            {
+                return path;
+            }
+            return path.empty() ? name.substr(name_begin) : path + "/" + name.substr(name_begin);
+        }
+
+        int getStateLevel(State state)
+        {
+            switch (state)
+            {
+            case State::unloaded: return 0;
+            case State::loaded: return 1;
+            case State::initialized: return 2;
+            case State::paused: return 3;
+            case State::running: return 4;
+            default: return -1;
+            }
+        }
+
+        State toState(fep3::SystemAggregatedState state)
+        {
+            switch (state)
+            {
+            case fep3::SystemAggregatedState::unloaded: return State::unloaded;
+            case fep3::SystemAggregatedState::loaded: return State::loaded;
+            case fep3::SystemAggregatedState::initialized: return State::initialized;
+            case fep3::SystemAggregatedState::paused: return State::paused;
+            case fep3::SystemAggregatedState::running: return State::running;
+            default:
+                throw std::runtime_error("the loopback system can not be set to an undefined or unreachable state");
+            }
+        }
+
+        fep3::SystemAggregatedState toAggregatedState(State state)
+        {
+            switch (state)
+            {
+            case State::unloaded: return fep3::SystemAggregatedState::unloaded;
+            case State::loaded: return fep3::SystemAggregatedState::loaded;
+            case State::initialized: return fep3::SystemAggregatedState::initialized;
+            case State::paused: return fep3::SystemAggregatedState::paused;
+            case State::running: return fep3::SystemAggregatedState::running;
+            case State::unreachable: return fep3::SystemAggregatedState::unreachable;
+            default: return fep3::SystemAggregatedState::undefined;
+            }
+        }
+
+        /**
+         * A node of the properties of a participant, every call is one round trip
+         */
+        class LoopbackProperties : public fep3::IProperties
+        {
+        public:
+            LoopbackProperties(std::shared_ptr<LoopbackParticipant> participant, const std::string& node_path)
+                : _participant(std::move(participant)),
+                  _node_path(node_path)
+            {
+            }
+
+            bool setProperty(const std::string& name, const std::string& value, const std::string& type) override
+            {
+                _participant->simulateConfigurationRequest();
+                return _participant->setPropertyValue(toPropertyPath(_node_path, name), value, type);
+            }
+
+            std::string getProperty(const std::string& name) const override
+            {
+                _participant->simulateConfigurationRequest();
+                return _participant->getPropertyValue(toPropertyPath(_node_path, name));
+            }
+
+            std::string getPropertyType(const std::string& name) const override
+            {
+                _participant->simulateConfigurationRequest();
+                return _participant->getPropertyType(toPropertyPath(_node_path, name));
+            }
+
+            bool isEqual(const fep3::IProperties& properties) const override
+            {
+                const auto names = getPropertyNames();
+                if (names != properties.getPropertyNames())
+                {
+                    return false;
+                }
+                return std::all_of(names.begin(), names.end(), [&](const std::string& name)
+                {
+                    return getProperty(name) == properties.getProperty(name)
+                        && getPropertyType(name) == properties.getPropertyType(name);
+                });
+            }
+
+            void copyTo(fep3::IProperties& properties) const override
+            {
+                for (const auto& name : getPropertyNames())
+                {
+                    properties.setProperty(name, getProperty(name), getPropertyType(name));
+                }
+            }
+
+            std::vector<std::string> getPropertyNames() const override
+            {
+                _participant->simulateConfigurationRequest();
+                const auto prefix = toPropertyPath(_node_path, "");
+                std::vector<std::string> names;
+                for (const auto& property : _participant->getProperties(prefix))
+                {
+                    names.push_back(prefix.empty() ? property.first : property.first.substr(prefix.size() + 1));
+                }
+                return names;
+            }
+
+        private:
+            std::shared_ptr<LoopbackParticipant> _participant;
+            const std::string _node_path;
+        };
+
+        class LoopbackConfiguration : public fep3::rpc::IRPCConfiguration
+        {
+        public:
+            explicit LoopbackConfiguration(std::shared_ptr<LoopbackParticipant> participant)
+                : _participant(std::move(participant))
+            {
+            }
+
+            std::shared_ptr<fep3::IProperties> getProperties(const std::string& property_path) override
+            {
+                _participant->simulateConfigurationRequest();
+                return std::make_shared<LoopbackProperties>(_participant, property_path);
+            }
+
+        private:
+            std::shared_ptr<LoopbackParticipant> _participant;
+        };
+
+        /// the message of a batch, shared by all participants it is sent to
+        struct LoopbackSerializedProperties : public ISerializedProperties
+        {
+            std::string _node_path;
+            std::vector<PropertyAssignment> _properties;
+        };
+
+        class LoopbackBatchWriter : public IPropertyBatchWriter
+        {
+        public:
+            explicit LoopbackBatchWriter(std::shared_ptr<LoopbackParticipant> participant)
+                : _participant(std::move(participant))
+            {
+            }
+
+            std::shared_ptr<const ISerializedProperties> serialize(const std::string& node_path,
+                const std::vector<PropertyAssignment>& properties) override
+            {
+                _participant->countSerialization();
+                auto serialized_properties = std::make_shared<LoopbackSerializedProperties>();
+                serialized_properties->_node_path = node_path;
+                serialized_properties->_properties = properties;
+                return serialized_properties;
+            }
+
+            std::vector<PropertyWriteError> setSerializedProperties(
+                const ISerializedProperties& serialized_properties) override
+            {
+                const auto& loopback_properties = dynamic_cast<const LoopbackSerializedProperties&>(serialized_properties);
+                return setProperties(loopback_properties._node_path, loopback_properties._properties);
+            }
+
+            std::vector<PropertyWriteError> setProperties(const std::string& node_path,
+                                                          const std::vector<PropertyAssignment>& properties) override
+            {
+                _participant->simulateConfigurationRequest();
+                std::vector<PropertyWriteError> errors;
+                for (size_t index = 0; index < properties.size(); ++index)
+                {
+                    const auto& property = properties[index];
+                    if (!_participant->setPropertyValue(toPropertyPath(node_path, property._name),
+                                                        property._value,
+                                                        property._type))
+                    {
+                        errors.push_back({ index, "refused by the loopback participant" });
+                    }
+                }
+                return errors;
+            }
+
+        private:
+            std::shared_ptr<LoopbackParticipant> _participant;
+        };
+
+        class LoopbackStateMachine : public fep3::rpc::IRPCParticipantStateMachine
+        {
+        public:
+            explicit LoopbackStateMachine(std::shared_ptr<LoopbackParticipant> participant)
+                : _participant(std::move(participant))
+            {
+            }
+
+            State getState() override
+            {
+                _participant->simulateRoundTrip();
+                return _participant->getState();
+            }
+
+            void load() override { transition({ State::unloaded }, State::loaded); }
+            void unload() override { transition({ State::loaded }, State::unloaded); }
+            void initialize() override { transition({ State::loaded }, State::initialized); }
+            void deinitialize() override { transition({ State::initialized }, State::loaded); }
+            void start() override { transition({ State::initialized, State::paused }, State::running); }
+            void stop() override { transition({ State::running, State::paused }, State::initialized); }
+            void pause() override { transition({ State::initialized, State::running }, State::paused); }
+            void exit() override { transition({ State::unloaded }, State::unreachable); }
+
+        private:
+            void transition(std::initializer_list<State> from, State to)
+            {
+                _participant->simulateRoundTrip();
+                const auto current = _participant->getState();
+                if (std::find(from.begin(), from.end(), current) == from.end())
+                {
+                    throw std::runtime_error("invalid state transition of participant " + _participant->getName());
+                }
+                _participant->setState(to);
+            }
+
+        private:
+            std::shared_ptr<LoopbackParticipant> _participant;
+        };
+    }
+
+    LoopbackParticipant::LoopbackParticipant(const std::string& name,
+                                             int32_t init_priority,
+                                             const LoopbackBehaviour& behaviour,
+                                             uint32_t seed)
+        : _name(name),
+          _init_priority(init_priority),
+          _behaviour(behaviour),
+          _engine(seed),
+          _state(State::unloaded)
+    {
+        _reachable = !isHit(_engine, _behaviour._unreachable_rate);
+        if (!_reachable)
+        {
+            _state = State::unreachable;
+        }
+    }
+
+    std::string LoopbackParticipant::getName() const
+    {
+        return _name;
+    }
+
+    int32_t LoopbackParticipant::getInitPriority() const
+    {
+        return _init_priority;
+    }
+
+    std::shared_ptr<fep3::rpc::IRPCConfiguration> LoopbackParticipant::getConfiguration()
+    {
+        throwIfUnreachable();
+        return std::make_shared<LoopbackConfiguration>(shared_from_this());
+    }
+
+    void LoopbackParticipant::dropConfiguration(const std::shared_ptr<fep3::rpc::IRPCConfiguration>&)
+    {
+        //every call of getConfiguration creates a new service anyway, the drop is only counted
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_statistics._configuration_drops;
+    }
+
+    std::shared_ptr<IPropertyBatchWriter> LoopbackParticipant::getBatchWriter()
+    {
+        if (!_behaviour._batch_writes)
+        {
+            return {};
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_batch_writer_withdrawn)
+            {
+                return {};
+            }
+            ++_statistics._batch_writers;
+        }
+        throwIfUnreachable();
+        return std::make_shared<LoopbackBatchWriter>(shared_from_this());
+    }
+
+    bool LoopbackParticipant::hasBatchWriter() const
+    {
+        return _behaviour._batch_writes;
+    }
+
+    void LoopbackParticipant::load()
+    {
+        auto state_machine = getStateMachine();
+        if (state_machine->getState() == State::unloaded)
+        {
+            state_machine->load();
+        }
+        if (getState() != State::loaded)
+        {
+            throw std::runtime_error("the participant " + _name + " is not in loaded state");
+        }
+    }
+
+    std::shared_ptr<fep3::rpc::IRPCParticipantStateMachine> LoopbackParticipant::getStateMachine()
+    {
+        throwIfUnreachable();
+        return std::make_shared<LoopbackStateMachine>(shared_from_this());
+    }
+
+    bool LoopbackParticipant::isReachable() const
+    {
+        return _reachable;
+    }
+
+    std::string LoopbackParticipant::getPropertyValue(const std::string& path) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _properties.find(path);
+        return found != _properties.end() ? found->second.second : std::string();
+    }
+
+    std::string LoopbackParticipant::getPropertyType(const std::string& path) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _properties.find(path);
+        return found != _properties.end() ? found->second.first : std::string();
+    }
+
+    size_t LoopbackParticipant::getPropertyCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _properties.size();
+    }
+
+    void LoopbackParticipant::countSerialization()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_statistics._serializations;
+    }
+
+    LoopbackStatistics LoopbackParticipant::getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _statistics;
+    }
+
+    void LoopbackParticipant::setExtraLatency(std::chrono::microseconds extra_latency)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _extra_latency = extra_latency;
+    }
+
+    void LoopbackParticipant::stallConfiguration()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stalled = true;
+    }
+
+    void LoopbackParticipant::releaseConfiguration()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stalled = false;
+        }
+        _released.notify_all();
+    }
+
+    void LoopbackParticipant::withdrawBatchWriter()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _batch_writer_withdrawn = true;
+    }
+
+    void LoopbackParticipant::simulateRoundTrip()
+    {
+        std::chrono::microseconds delay = _behaviour._latency;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_statistics._round_trips;
+            delay += _extra_latency;
+            if (_behaviour._jitter.count() > 0)
+            {
+                delay += std::chrono::microseconds(_engine() % (static_cast<uint64_t>(_behaviour._jitter.count()) + 1));
+            }
+        }
+        if (delay.count() > 0)
+        {
+            std::this_thread::sleep_for(delay);
+        }
+    }
+
+    void LoopbackParticipant::simulateConfigurationRequest()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_stalled)
+            {
+                ++_statistics._stalled_requests;
+                _released.wait(lock, [this]() { return !_stalled; });
+            }
+        }
+        simulateRoundTrip();
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (isHit(_engine, _behaviour._transient_failure_rate))
+        {
+            throw std::runtime_error("transient failure of participant " + _name);
+        }
+    }
+
+    bool LoopbackParticipant::setPropertyValue(const std::string& path, const std::string& value, const std::string& type)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (isRefused())
+        {
+            ++_statistics._properties_refused;
+            return false;
+        }
+        _properties[path] = std::make_pair(type, value);
+        ++_statistics._properties_set;
+        return true;
+    }
+
+    std::vector<std::pair<std::string, std::pair<std::string, std::string>>>
+        LoopbackParticipant::getProperties(const std::string& prefix) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<std::pair<std::string, std::pair<std::string, std::string>>> properties;
+        for (const auto& property : _properties)
+        {
+            if (prefix.empty()
+                || (property.first.size() > prefix.size()
+                    && property.first.compare(0, prefix.size(), prefix) == 0
+                    && property.first[prefix.size()] == '/'))
+            {
+                properties.push_back(property);
+            }
+        }
+        return properties;
+    }
+
+    State LoopbackParticipant::getState() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _state;
+    }
+
+    void LoopbackParticipant::setState(State state)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _state = state;
+    }
+
+    bool LoopbackParticipant::isRefused()
+    {
+        return isHit(_engine, _behaviour._property_failure_rate);
+    }
+
+    void LoopbackParticipant::throwIfUnreachable() const
+    {
+        if (!_reachable)
+        {
+            throw std::runtime_error("participant " + _name + " is not reachable");
+        }
+    }
+
+    LoopbackSystem::LoopbackSystem(const std::string& system_name, const LoopbackBehaviour& behaviour)
+        : _system_name(system_name),
+          _behaviour(behaviour)
+    {
+    }
+
+    std::shared_ptr<LoopbackParticipant> LoopbackSystem::add(const std::string& participant_name, int32_t init_priority)
+    {
+        if (getParticipant(participant_name))
+        {
+            throw std::runtime_error("participant " + participant_name + " already exists in " + _system_name);
+        }
+        const auto seed = _behaviour._seed + static_cast<uint32_t>(_participants.size()) * 2654435761u;
+        _participants.push_back(std::make_shared<LoopbackParticipant>(participant_name, init_priority, _behaviour, seed));
+        return _participants.back();
+    }
+
+    std::shared_ptr<LoopbackParticipant> LoopbackSystem::getParticipant(const std::string& participant_name) const
+    {
+        auto found = std::find_if(_participants.begin(), _participants.end(),
+            [&participant_name](const std::shared_ptr<LoopbackParticipant>& participant)
+            {
+                return participant->getName() == participant_name;
+            });
+        return found != _participants.end() ? *found : nullptr;
+    }
+
+    LoopbackStatistics LoopbackSystem::getStatistics() const
+    {
+        LoopbackStatistics statistics;
+        for (const auto& participant : _participants)
+        {
+            const auto participant_statistics = participant->getStatistics();
+            statistics._round_trips += participant_statistics._round_trips;
+            statistics._properties_set += participant_statistics._properties_set;
+            statistics._properties_refused += participant_statistics._properties_refused;
+            statistics._serializations += participant_statistics._serializations;
+            statistics._batch_writers += participant_statistics._batch_writers;
+            statistics._configuration_drops += participant_statistics._configuration_drops;
+            statistics._stalled_requests += participant_statistics._stalled_requests;
+        }
+        return statistics;
+    }
+
+    std::string LoopbackSystem::getTimingConfiguration() const
+    {
+        return _timing_configuration;
+    }
+
+    std::string LoopbackSystem::getSystemName() const
+    {
+        return _system_name;
+    }
+
+    std::vector<std::shared_ptr<IParticipantAccess>> LoopbackSystem::getParticipants()
+    {
+        return std::vector<std::shared_ptr<IParticipantAccess>>(_participants.begin(), _participants.end());
+    }
+
+    void LoopbackSystem::setSystemState(fep3::SystemAggregatedState state, std::chrono::milliseconds timeout)
+    {
+        const auto target = toState(state);
+        const auto target_level = getStateLevel(target);
+        const auto begin = std::chrono::steady_clock::now();
+        for (const auto& participant : _participants)
+        {
+            if (timeout.count() > 0 && std::chrono::steady_clock::now() - begin > timeout)
+            {
+                throw std::runtime_error("the state transition of " + _system_name + " timed out");
+            }
+            auto state_machine = participant->getStateMachine();
+            auto current = participant->getState();
+            while (current != target)
+            {
+                const auto current_level = getStateLevel(current);
+                if (current_level < target_level)
+                {
+                    switch (current)
+                    {
+                    case State::unloaded: state_machine->load(); break;
+                    case State::loaded: state_machine->initialize(); break;
+                    case State::initialized:
+                        target == State::paused ? state_machine->pause() : state_machine->start();
+                        break;
+                    default: state_machine->start(); break;
+                    }
+                }
+                else
+                {
+                    switch (current)
+                    {
+                    case State::running:
+                    case State::paused: state_machine->stop(); break;
+                    case State::initialized: state_machine->deinitialize(); break;
+                    default: state_machine->unload(); break;
+                    }
+                }
+                current = participant->getState();
+            }
+        }
+    }
+
+    fep3::SystemState LoopbackSystem::getSystemState()
+    {
+        if (_participants.empty())
+        {
+            return { fep3::SystemAggregatedState::undefined, true };
+        }
+        //the aggregated state is the lowest state of all participants
+        auto lowest = _participants.front()->getState();
+        bool homogeneous = true;
+        for (const auto& participant : _participants)
+        {
+            const auto state = participant->getState();
+            homogeneous = homogeneous && state == lowest;
+            if (state == State::unreachable || getStateLevel(state) < getStateLevel(lowest))
+            {
+                lowest = state;
+            }
+        }
+        return { toAggregatedState(lowest), homogeneous };
+    }
+
+    void LoopbackSystem::configureTiming(const std::string& timing_configuration,
+                                         const std::vector<std::pair<std::string, std::string>>& clock_properties)
+    {
+        for (const auto& participant : _participants)
+        {
+            auto configuration = participant->getConfiguration();
+            auto root = configuration->getProperties("/");
+            for (const auto& clock_property : clock_properties)
+            {
+                if (!root->setProperty(clock_property.first, clock_property.second, "string"))
+                {
+                    throw std::runtime_error("unable to configure the timing of participant " + participant->getName());
+                }
+            }
+        }
+        _timing_configuration = timing_configuration;
+    }
+
+    void LoopbackSystem::configureTiming3NoMaster()
+    {
+        configureTiming("Timing3NoMaster",
+                        { { "clock/main_clock", "local_system_realtime" },
+                          { "clock_synchronization/timing_master", "" } });
+    }
+
+    void LoopbackSystem::configureTiming3ClockSyncOnlyInterpolation(const std::string& master_element_id,
+                                                                    const std::string& slave_sync_cycle_time)
+    {
+        configureTiming("Timing3ClockSyncOnlyInterpolation(" + master_element_id + "," + slave_sync_cycle_time + ")",
+                        { { "clock/main_clock", "slave_master_on_demand" },
+                          { "clock_synchronization/timing_master", master_element_id },
+                          { "clock_synchronization/sync_cycle_time", slave_sync_cycle_time } });
+    }
+
+    void LoopbackSystem::configureTiming3ClockSyncOnlyDiscrete(const std::string& master_element_id,
+                                                               const std::string& slave_sync_cycle_time)
+    {
+        configureTiming("Timing3ClockSyncOnlyDiscrete(" + master_element_id + "," + slave_sync_cycle_time + ")",
+                        { { "clock/main_clock", "slave_master_on_demand_discrete" },
+                          { "clock_synchronization/timing_master", master_element_id },
+                          { "clock_synchronization/sync_cycle_time", slave_sync_cycle_time } });
+    }
+
+    void LoopbackSystem::configureTiming3DiscreteSteps(const std::string& master_element_id,
+                                                       const std::string& master_time_stepsize,
+                                                       const std::string& master_time_factor)
+    {
+        configureTiming("Timing3DiscreteSteps(" + master_element_id + "," + master_time_stepsize + "," + master_time_factor + ")",
+                        { { "clock/main_clock", "local_system_simtime" },
+                          { "clock/step_size", master_time_stepsize },
+                          { "clock/time_factor", master_time_factor },
+                          { "clock_synchronization/timing_master", master_element_id } });
+    }
+
+    void LoopbackSystem::configureTiming3AFAP(const std::string& master_element_id,
+                                              const std::string& master_time_stepsize)
+    {
+        configureTiming("Timing3AFAP(" + master_element_id + "," + master_time_stepsize + ")",
+                        { { "clock/main_clock", "local_system_simtime" },
+                          { "clock/step_size", master_time_stepsize },
+                          { "clock/time_factor", "0.0" },
+                          { "clock_synchronization/timing_master", master_element_id } });
+    }
+} // namespace test
+} // namespace controller
+} // namespace fep3
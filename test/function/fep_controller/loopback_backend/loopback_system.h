@@ -0,0 +1,221 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <fep_controller/system_access_intf.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+namespace test
+{
+    /**
+     * How the in-process participants behave.
+     * The same behaviour (including the seed) always injects the same latencies and failures
+     * into a participant, independent of the threads the controller uses.
+     */
+    struct LoopbackBehaviour
+    {
+        /// time every RPC round trip takes
+        std::chrono::microseconds _latency{ 0 };
+        /// additional time of every round trip, uniformly distributed within [0, _jitter]
+        std::chrono::microseconds _jitter{ 0 };
+        /// probability that a setProperty is refused
+        double _property_failure_rate = 0.0;
+        /// probability that a request to the configuration service fails with an exception
+        double _transient_failure_rate = 0.0;
+        /// probability that a participant is not reachable at all (decided once per participant)
+        double _unreachable_rate = 0.0;
+        /// if true, the participants provide a batch writer setting all properties of a node within one round trip
+        bool _batch_writes = false;
+        /// seed of the injected jitter and failures
+        uint32_t _seed = 0;
+    };
+
+    /// what happened at the participants
+    struct LoopbackStatistics
+    {
+        /// number of simulated RPC round trips
+        uint64_t _round_trips = 0;
+        /// number of properties set
+        uint64_t _properties_set = 0;
+        /// number of properties refused
+        uint64_t _properties_refused = 0;
+        /// number of property batches serialized to be sent to several participants
+        uint64_t _serializations = 0;
+        /// number of batch writers created
+        uint64_t _batch_writers = 0;
+        /// number of configuration services dropped after a failed request
+        uint64_t _configuration_drops = 0;
+        /// number of configuration requests stalled by @ref LoopbackParticipant::stallConfiguration
+        uint64_t _stalled_requests = 0;
+    };
+
+    /**
+     * A participant living in the process of the controller.
+     * It implements the configuration and state machine RPC services on a plain property map.
+     */
+    class LoopbackParticipant : public IParticipantAccess,
+                                public std::enable_shared_from_this<LoopbackParticipant>
+    {
+    public:
+        LoopbackParticipant(const std::string& name,
+                            int32_t init_priority,
+                            const LoopbackBehaviour& behaviour,
+                            uint32_t seed);
+
+        std::string getName() const override;
+        int32_t getInitPriority() const override;
+        std::shared_ptr<fep3::rpc::IRPCConfiguration> getConfiguration() override;
+        void dropConfiguration(const std::shared_ptr<fep3::rpc::IRPCConfiguration>& configuration) override;
+        std::shared_ptr<IPropertyBatchWriter> getBatchWriter() override;
+        bool hasBatchWriter() const override;
+        void load() override;
+
+        /**
+         * @return the state machine RPC service
+         * @throws std::runtime_error if the participant is not reachable
+         */
+        std::shared_ptr<fep3::rpc::IRPCParticipantStateMachine> getStateMachine();
+
+        /// @return false if the participant was created unreachable
+        bool isReachable() const;
+        /// @return the value of the property @p path ("node/property", without leading '/'), empty if not set
+        std::string getPropertyValue(const std::string& path) const;
+        /// @return the type of the property @p path, empty if not set
+        std::string getPropertyType(const std::string& path) const;
+        /// @return the number of properties set on this participant
+        size_t getPropertyCount() const;
+        /// @return what happened at this participant
+        LoopbackStatistics getStatistics() const;
+        /**
+         * Slows down every following round trip of this participant (e.g. to simulate a stalled participant)
+         *
+         * @param [in] extra_latency the time added to every round trip
+         */
+        void setExtraLatency(std::chrono::microseconds extra_latency);
+        /**
+         * Blocks every following configuration request of this participant until @ref releaseConfiguration
+         * (e.g. to simulate a participant which stopped responding, independent of the timing)
+         */
+        void stallConfiguration();
+        /// answers the stalled configuration requests and the following ones again
+        void releaseConfiguration();
+        /**
+         * Lets @ref getBatchWriter return nullptr while @ref hasBatchWriter still promises a writer
+         * (e.g. to simulate a writer factory not supporting this participant)
+         */
+        void withdrawBatchWriter();
+
+        /// @cond nodoc
+        // used by the rpc services of the participant
+        void simulateRoundTrip();
+        /// a round trip to the configuration service, which might fail transiently
+        void simulateConfigurationRequest();
+        void countSerialization();
+        bool setPropertyValue(const std::string& path, const std::string& value, const std::string& type);
+        std::vector<std::pair<std::string, std::pair<std::string, std::string>>> getProperties(const std::string& prefix) const;
+        fep3::rpc::IRPCParticipantStateMachine::State getState() const;
+        void setState(fep3::rpc::IRPCParticipantStateMachine::State state);
+        /// @endcond
+
+    private:
+        bool isRefused();
+        void throwIfUnreachable() const;
+
+    private:
+        const std::string _name;
+        const int32_t _init_priority;
+        const LoopbackBehaviour _behaviour;
+        bool _reachable;
+        std::chrono::microseconds _extra_latency{ 0 };
+        bool _stalled = false;
+        bool _batch_writer_withdrawn = false;
+        mutable std::mutex _mutex;
+        std::condition_variable _released;
+        std::mt19937 _engine;
+        std::map<std::string, std::pair<std::string, std::string>> _properties;
+        fep3::rpc::IRPCParticipantStateMachine::State _state;
+        LoopbackStatistics _statistics;
+    };
+
+    /**
+     * A system of @ref LoopbackParticipant.
+     * Passed to configureSystemProperties it allows to measure the controller with thousands of
+     * participants without service discovery and network.
+     */
+    class LoopbackSystem : public ISystemAccess
+    {
+    public:
+        explicit LoopbackSystem(const std::string& system_name,
+                                const LoopbackBehaviour& behaviour = LoopbackBehaviour());
+
+        /**
+         * Adds a participant, the participants are seeded by their position within the system.
+         *
+         * @return the added participant
+         */
+        std::shared_ptr<LoopbackParticipant> add(const std::string& participant_name, int32_t init_priority = 0);
+        /// @return the participant named @p participant_name, nullptr if there is none
+        std::shared_ptr<LoopbackParticipant> getParticipant(const std::string& participant_name) const;
+        /// @return the sum of the statistics of all participants
+        LoopbackStatistics getStatistics() const;
+        /// @return the last timing configuration ("Timing3AFAP(master,100)"), empty if none was configured
+        std::string getTimingConfiguration() const;
+
+        std::string getSystemName() const override;
+        std::vector<std::shared_ptr<IParticipantAccess>> getParticipants() override;
+        void setSystemState(fep3::SystemAggregatedState state, std::chrono::milliseconds timeout) override;
+        fep3::SystemState getSystemState() override;
+
+        void configureTiming3NoMaster() override;
+        void configureTiming3ClockSyncOnlyInterpolation(const std::string& master_element_id,
+                                                        const std::string& slave_sync_cycle_time) override;
+        void configureTiming3ClockSyncOnlyDiscrete(const std::string& master_element_id,
+                                                   const std::string& slave_sync_cycle_time) override;
+        void configureTiming3DiscreteSteps(const std::string& master_element_id,
+                                           const std::string& master_time_stepsize,
+                                           const std::string& master_time_factor) override;
+        void configureTiming3AFAP(const std::string& master_element_id,
+                                  const std::string& master_time_stepsize) override;
+
+    private:
+        void configureTiming(const std::string& timing_configuration,
+                             const std::vector<std::pair<std::string, std::string>>& clock_properties);
+
+    private:
+        const std::string _system_name;
+        const LoopbackBehaviour _behaviour;
+        std::vector<std::shared_ptr<LoopbackParticipant>> _participants;
+        std::string _timing_configuration;
+    };
+} // namespace test
+} // namespace controller
+} // namespace fep3
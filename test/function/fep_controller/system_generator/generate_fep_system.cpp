@@ -0,0 +1,132 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "system_generator.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace fep3::controller::test;
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout <<
+            "Writes a synthetic <name>.fep_sdk_system and <name>.fep_system_properties\n"
+            "\n"
+            "generate_fep_system [options]\n"
+            "  --output <directory>          existing directory to write to (default: .)\n"
+            "  --name <base name>            base name of the files (default: generated)\n"
+            "  --system-name <name>          name of the system (default: FEP_SYSTEM_GENERATED)\n"
+            "  --participants <count>        number of participants (default: 2)\n"
+            "  --properties <count>          element properties per participant (default: 10)\n"
+            "  --system-properties <count>   number of system properties (default: 1)\n"
+            "  --type-mix <i>,<d>,<b>,<s>    weights of int, double, bool and string properties (default: 1,1,1,1)\n"
+            "  --property-node <node>        node of the generated properties (default: generated)\n"
+            "  --timing <type>               timing_configuration_type (default: PropertyBased)\n"
+            "  --timing-master <index>       index of the timing master participant (default: 0)\n"
+            "  --timing-files <count>        number of shared timing file references (default: 0)\n"
+            "  --mapping-files <count>       number of shared mapping file references (default: 0)\n"
+            "  --priority-levels <count>     number of distinct init/start priorities (default: 1)\n"
+            "  --seed <seed>                 seed of the generated types and values (default: 0)\n";
+    }
+
+    size_t toCount(const std::string& argument, const std::string& value)
+    {
+        char* end = nullptr;
+        const auto count = std::strtoull(value.c_str(), &end, 10);
+        if (value.empty() || *end != '\0')
+        {
+            throw std::runtime_error("invalid value '" + value + "' for " + argument);
+        }
+        return static_cast<size_t>(count);
+    }
+
+    PropertyTypeMix toTypeMix(const std::string& value)
+    {
+        uint32_t weights[4] = { 0, 0, 0, 0 };
+        size_t begin = 0;
+        for (size_t index = 0; index < 4; ++index)
+        {
+            const auto end = value.find(',', begin);
+            if ((end == std::string::npos) != (index == 3))
+            {
+                throw std::runtime_error("invalid value '" + value + "' for --type-mix");
+            }
+            weights[index] = static_cast<uint32_t>(toCount("--type-mix", value.substr(begin, end - begin)));
+            begin = end + 1;
+        }
+        PropertyTypeMix mix;
+        mix._int_weight = weights[0];
+        mix._double_weight = weights[1];
+        mix._bool_weight = weights[2];
+        mix._string_weight = weights[3];
+        return mix;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    SystemGeneratorOptions options;
+    std::string output_directory = ".";
+    std::string base_name = "generated";
+    try
+    {
+        for (int index = 1; index < argc; ++index)
+        {
+            const std::string argument = argv[index];
+            if (argument == "--help" || argument == "-h")
+            {
+                printUsage();
+                return 0;
+            }
+            if (index + 1 >= argc)
+            {
+                throw std::runtime_error("missing value for " + argument);
+            }
+            const std::string value = argv[++index];
+            if (argument == "--output") output_directory = value;
+            else if (argument == "--name") base_name = value;
+            else if (argument == "--system-name") options._system_name = value;
+            else if (argument == "--participants") options._participant_count = toCount(argument, value);
+            else if (argument == "--properties") options._property_count = toCount(argument, value);
+            else if (argument == "--system-properties") options._system_property_count = toCount(argument, value);
+            else if (argument == "--type-mix") options._property_type_mix = toTypeMix(value);
+            else if (argument == "--property-node") options._property_node = value;
+            else if (argument == "--timing") options._timing_configuration_type = value;
+            else if (argument == "--timing-master") options._timing_master_index = toCount(argument, value);
+            else if (argument == "--timing-files") options._timing_file_count = toCount(argument, value);
+            else if (argument == "--mapping-files") options._mapping_file_count = toCount(argument, value);
+            else if (argument == "--priority-levels") options._priority_levels = toCount(argument, value);
+            else if (argument == "--seed") options._seed = static_cast<uint32_t>(toCount(argument, value));
+            else throw std::runtime_error("unknown option " + argument);
+        }
+
+        const auto files = generateSystemFiles(options, output_directory, base_name);
+        std::cout << files._system_description_file << "\n" << files._system_properties_file << std::endl;
+    }
+    catch (const std::exception& error)
+    {
+        std::cerr << error.what() << std::endl;
+        printUsage();
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,264 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#include "system_generator.h"
+
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace fep3
+{
+namespace controller
+{
+namespace test
+{
+    namespace
+    {
+        // std::mt19937 is specified bit by bit, the distributions of the standard library are not,
+        // so all values are derived from the raw engine output to be reproducible on every platform
+        using Engine = std::mt19937;
+
+        uint32_t getValueSeed(uint32_t seed)
+        {
+            return seed ^ 0x9e3779b9u;
+        }
+
+        std::string escapeXml(const std::string& text)
+        {
+            std::string escaped;
+            escaped.reserve(text.size());
+            for (const auto character : text)
+            {
+                switch (character)
+                {
+                case '&': escaped.append("&amp;"); break;
+                case '<': escaped.append("&lt;"); break;
+                case '>': escaped.append("&gt;"); break;
+                case '"': escaped.append("&quot;"); break;
+                default: escaped.push_back(character); break;
+                }
+            }
+            return escaped;
+        }
+
+        std::string makeValue(const std::string& type, Engine& engine)
+        {
+            const auto random = engine();
+            if (type == "int")
+            {
+                return std::to_string(static_cast<int64_t>(random % 2001) - 1000);
+            }
+            else if (type == "double")
+            {
+                std::ostringstream value;
+                value.precision(3);
+                value << std::fixed << (static_cast<double>(random % 2000001) / 1000.0 - 1000.0);
+                return value.str();
+            }
+            else if (type == "bool")
+            {
+                return (random % 2) ? "true" : "false";
+            }
+            return "value_" + std::to_string(random % 100000);
+        }
+
+        void writeProperty(std::ostream& stream,
+                           const std::string& indent,
+                           const std::string& name,
+                           const std::string& type,
+                           const std::string& value)
+        {
+            stream << indent << "<property>\n"
+                   << indent << "    <name>" << escapeXml(name) << "</name>\n"
+                   << indent << "    <type>" << type << "</type>\n"
+                   << indent << "    <value>" << escapeXml(value) << "</value>\n"
+                   << indent << "</property>\n";
+        }
+
+        void writeFileReference(std::ostream& stream,
+                                const std::string& tag,
+                                const std::string& file_reference)
+        {
+            stream << "                <" << tag << ">\n"
+                   << "                    <file_reference>" << escapeXml(file_reference) << "</file_reference>\n"
+                   << "                </" << tag << ">\n";
+        }
+
+        void writeFile(const std::string& file_path,
+                       const SystemGeneratorOptions& options,
+                       void (*write)(const SystemGeneratorOptions&, std::ostream&))
+        {
+            std::ofstream file_stream(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!file_stream.is_open())
+            {
+                throw std::runtime_error("unable to open '" + file_path + "' for writing");
+            }
+            write(options, file_stream);
+            file_stream.close();
+            if (file_stream.fail())
+            {
+                throw std::runtime_error("unable to write '" + file_path + "'");
+            }
+        }
+    }
+
+    std::string getGeneratedParticipantName(size_t index)
+    {
+        return "participant_" + std::to_string(index);
+    }
+
+    std::vector<GeneratedProperty> getGeneratedProperties(const SystemGeneratorOptions& options)
+    {
+        const auto& mix = options._property_type_mix;
+        const uint64_t total_weight = static_cast<uint64_t>(mix._int_weight) + mix._double_weight
+            + mix._bool_weight + mix._string_weight;
+        if (total_weight == 0 && options._property_count > 0)
+        {
+            throw std::runtime_error("the property type mix must contain at least one type");
+        }
+
+        Engine engine(options._seed);
+        std::vector<GeneratedProperty> properties;
+        properties.reserve(options._property_count);
+        for (size_t index = 0; index < options._property_count; ++index)
+        {
+            auto pick = engine() % total_weight;
+            std::string type;
+            if (pick < mix._int_weight)
+            {
+                type = "int";
+            }
+            else if ((pick -= mix._int_weight) < mix._double_weight)
+            {
+                type = "double";
+            }
+            else if ((pick -= mix._double_weight) < mix._bool_weight)
+            {
+                type = "bool";
+            }
+            else
+            {
+                type = "string";
+            }
+            properties.push_back({ options._property_node + "/property_" + std::to_string(index), type });
+        }
+        return properties;
+    }
+
+    void writeSystemDescription(const SystemGeneratorOptions& options, std::ostream& stream)
+    {
+        const size_t priority_levels = options._priority_levels > 0 ? options._priority_levels : 1;
+        stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               << "<system xmlns=\"http://fep.vwgroup.com/system/2.0/sdk\">\n"
+               << "    <schema_version>2.0.0</schema_version>\n"
+               << "    <name>" << escapeXml(options._system_name) << "</name>\n"
+               << "    <id>" << escapeXml(options._system_name) << "</id>\n"
+               << "    <description>generated system</description>\n"
+               << "    <version>1.0.0</version>\n"
+               << "    <author>system_generator</author>\n"
+               << "    <participants>\n";
+        for (size_t index = 0; index < options._participant_count; ++index)
+        {
+            const auto name = getGeneratedParticipantName(index);
+            const auto priority = std::to_string(index % priority_levels);
+            stream << "        <participant>\n"
+                   << "            <address>" << name << "</address>\n"
+                   << "            <init_priority>" << priority << "</init_priority>\n"
+                   << "            <start_priority>" << priority << "</start_priority>\n"
+                   << "            <element_instance>\n"
+                   << "                <id>" << name << "</id>\n"
+                   << "                <type>type_id</type>\n";
+            if (options._timing_file_count > 0)
+            {
+                writeFileReference(stream, "timing",
+                    "timing/timing_" + std::to_string(index % options._timing_file_count) + ".xml");
+            }
+            if (options._mapping_file_count > 0)
+            {
+                const auto mapping_index = std::to_string(index % options._mapping_file_count);
+                writeFileReference(stream, "input_mapping", "mapping/input_" + mapping_index + ".map");
+                writeFileReference(stream, "output_mapping", "mapping/output_" + mapping_index + ".map");
+            }
+            stream << "            </element_instance>\n"
+                   << "        </participant>\n";
+        }
+        stream << "    </participants>\n"
+               << "</system>\n";
+    }
+
+    void writeSystemProperties(const SystemGeneratorOptions& options, std::ostream& stream)
+    {
+        const auto properties = getGeneratedProperties(options);
+        Engine engine(getValueSeed(options._seed));
+
+        stream << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+               << "<property_file xmlns=\"http://fep.vwgroup.com/system/2.0/properties\">\n"
+               << "    <schema_version>2.0.0</schema_version>\n"
+               << "    <system_timing_properties>\n";
+        const std::string timing_indent = "        ";
+        writeProperty(stream, timing_indent, "timing_configuration_type", "string", options._timing_configuration_type);
+        if (options._timing_configuration_type.find("Timing3") == 0 && options._participant_count > 0)
+        {
+            const auto master_index = options._timing_master_index < options._participant_count
+                ? options._timing_master_index
+                : 0;
+            writeProperty(stream, timing_indent, "master_element_id", "string", getGeneratedParticipantName(master_index));
+            writeProperty(stream, timing_indent, "master_time_stepsize", "uint", "100");
+            writeProperty(stream, timing_indent, "master_time_factor", "double", "1.0");
+            writeProperty(stream, timing_indent, "slave_time_stepsize", "uint", "100");
+        }
+        stream << "    </system_timing_properties>\n"
+               << "    <system_properties>\n";
+        for (size_t index = 0; index < options._system_property_count; ++index)
+        {
+            writeProperty(stream, timing_indent, "system_property_" + std::to_string(index), "int", makeValue("int", engine));
+        }
+        stream << "    </system_properties>\n"
+               << "    <element_instances_properties>\n";
+        for (size_t index = 0; index < options._participant_count; ++index)
+        {
+            stream << "        <element_instance>\n"
+                   << "            <id>" << getGeneratedParticipantName(index) << "</id>\n"
+                   << "            <properties>\n";
+            for (const auto& property : properties)
+            {
+                writeProperty(stream, "                ", property._name, property._type, makeValue(property._type, engine));
+            }
+            stream << "            </properties>\n"
+                   << "        </element_instance>\n";
+        }
+        stream << "    </element_instances_properties>\n"
+               << "</property_file>\n";
+    }
+
+    GeneratedSystemFiles generateSystemFiles(const SystemGeneratorOptions& options,
+                                             const std::string& directory,
+                                             const std::string& base_name)
+    {
+        const std::string prefix = directory.empty() ? base_name : directory + "/" + base_name;
+        GeneratedSystemFiles files;
+        files._system_description_file = prefix + ".fep_sdk_system";
+        files._system_properties_file = prefix + ".fep_system_properties";
+        writeFile(files._system_description_file, options, &writeSystemDescription);
+        writeFile(files._system_properties_file, options, &writeSystemProperties);
+        return files;
+    }
+} // namespace test
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,120 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace fep3
+{
+namespace controller
+{
+namespace test
+{
+    /**
+     * Weights of the property types within the generated properties.
+     * A type with weight 0 is not generated.
+     */
+    struct PropertyTypeMix
+    {
+        uint32_t _int_weight = 1;
+        uint32_t _double_weight = 1;
+        uint32_t _bool_weight = 1;
+        uint32_t _string_weight = 1;
+    };
+
+    /**
+     * Describes the synthetic system to generate.
+     * The same options (including the seed) always generate the same files.
+     */
+    struct SystemGeneratorOptions
+    {
+        /// name of the system
+        std::string _system_name = "FEP_SYSTEM_GENERATED";
+        /// number of participants, named "participant_<index>"
+        size_t _participant_count = 2;
+        /// number of element properties per participant
+        size_t _property_count = 10;
+        /// number of system properties
+        size_t _system_property_count = 1;
+        /// mix of the types of the generated properties
+        PropertyTypeMix _property_type_mix;
+        /// node the generated properties are placed in
+        std::string _property_node = "generated";
+        /// the timing_configuration_type, "PropertyBased" or one of the "Timing3*" types
+        std::string _timing_configuration_type = "PropertyBased";
+        /// index of the participant used as timing master
+        size_t _timing_master_index = 0;
+        /// number of timing files the participants refer to round robin (0 writes no timing references)
+        size_t _timing_file_count = 0;
+        /// number of input and output mapping files the participants refer to round robin (0 writes no mapping references)
+        size_t _mapping_file_count = 0;
+        /// number of distinct init and start priorities, distributed round robin
+        size_t _priority_levels = 1;
+        /// seed of the generated types and values
+        uint32_t _seed = 0;
+    };
+
+    /**
+     * A generated property, the same @p index has the same name and type within every participant
+     */
+    struct GeneratedProperty
+    {
+        std::string _name;
+        std::string _type;
+    };
+
+    /// files written by @ref generateSystemFiles
+    struct GeneratedSystemFiles
+    {
+        std::string _system_description_file;
+        std::string _system_properties_file;
+    };
+
+    /// @return the name of the participant with index @p index
+    std::string getGeneratedParticipantName(size_t index);
+
+    /**
+     * @return the element properties generated for every participant (name and type),
+     *         values differ from participant to participant
+     */
+    std::vector<GeneratedProperty> getGeneratedProperties(const SystemGeneratorOptions& options);
+
+    /**
+     * Writes the system sdk description (.fep_sdk_system) for @p options to @p stream
+     */
+    void writeSystemDescription(const SystemGeneratorOptions& options, std::ostream& stream);
+
+    /**
+     * Writes the system properties (.fep_system_properties) for @p options to @p stream
+     */
+    void writeSystemProperties(const SystemGeneratorOptions& options, std::ostream& stream);
+
+    /**
+     * Writes "<base_name>.fep_sdk_system" and "<base_name>.fep_system_properties" into the existing @p directory
+     *
+     * @throws std::runtime_error if a file can not be written
+     */
+    GeneratedSystemFiles generateSystemFiles(const SystemGeneratorOptions& options,
+                                             const std::string& directory,
+                                             const std::string& base_name);
+} // namespace test
+} // namespace controller
+} // namespace fep3
@@ -0,0 +1,959 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+   
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+   
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+   
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+
+ /**
+ * Test Case:   TestLoopbackSystem
+ * Test ID:     1.0
+ * Test Title:  FEP Controller configuration of in-process participants
+ * Description: Test the configuration of large systems without service bus
+ * Strategy:    Configure a loopback system generated by the system generator
+ * Passed If:   no errors occur
+ * Ticket:      -
+ * Requirement: -
+ */
+
+#include <gtest/gtest.h>
+#include <fep_controller/fep_controller.h>
+#include <fep_controller/properties_watcher.h>
+#include <fep_controller/property_export.h>
+#include <fep_controller/property_overlay.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <memory>
+#include <vector>
+
+#include "loopback_system.h"
+#include "system_generator.h"
+
+using namespace fep3::controller;
+
+namespace
+{
+    /**
+     * Tests on loopback systems generated by the system generator.
+     * A test describes the system within _options and calls setUpSystem,
+     * further systems of the same participants are created by createSystem.
+     */
+    class TesterControllerLibLoopback : public ::testing::Test
+    {
+    protected:
+        /// generates the files of the system described by _options into the directory @p name
+        void generateFiles(const std::string& name)
+        {
+            _files = test::generateSystemFiles(_options, GENERATED_FILES_DIR, name);
+        }
+
+        /// generates the files (see generateFiles) and creates _system with @p behaviour
+        void setUpSystem(const std::string& name, const test::LoopbackBehaviour& behaviour = test::LoopbackBehaviour())
+        {
+            generateFiles(name);
+            _system = createSystem(behaviour);
+        }
+
+        /// @return a new system of the participants described by _options
+        std::unique_ptr<test::LoopbackSystem> createSystem(const test::LoopbackBehaviour& behaviour) const
+        {
+            auto system = std::make_unique<test::LoopbackSystem>(_options._system_name, behaviour);
+            for (size_t index = 0; index < _options._participant_count; ++index)
+            {
+                // same init priorities as within the generated system description
+                system->add(test::getGeneratedParticipantName(index),
+                            static_cast<int32_t>(index % _options._priority_levels));
+            }
+            return system;
+        }
+
+    protected:
+        test::SystemGeneratorOptions _options;
+        test::GeneratedSystemFiles _files;
+        std::unique_ptr<test::LoopbackSystem> _system;
+    };
+}
+
+/**
+ * @detail Test the configuration of a large system of in-process participants
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystem)
+{
+    _options._participant_count = 1000;
+    _options._property_count = 20;
+    _options._timing_configuration_type = "Timing3AFAP";
+    setUpSystem("loopback");
+
+    ConfigureOptions configure_options;
+    configure_options._worker_count = 8;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+
+    EXPECT_EQ(_system->getSystemState()._state, fep3::SystemAggregatedState::loaded);
+    EXPECT_EQ(_system->getTimingConfiguration(), "Timing3AFAP(participant_0,100)");
+    const auto generated_properties = test::getGeneratedProperties(_options);
+    for (size_t index = 0; index < _options._participant_count; ++index)
+    {
+        const auto participant = _system->getParticipant(test::getGeneratedParticipantName(index));
+        ASSERT_TRUE(participant);
+        for (const auto& property : generated_properties)
+        {
+            EXPECT_EQ(participant->getPropertyType(property._name), property._type) << participant->getName();
+            EXPECT_FALSE(participant->getPropertyValue(property._name).empty()) << participant->getName();
+        }
+        EXPECT_EQ(participant->getPropertyValue("system/system_property_0").empty(), false);
+    }
+
+    const auto statistics = _system->getStatistics();
+    EXPECT_EQ(statistics._properties_refused, 0u);
+    // every participant: element and system properties, plus the clock properties of the timing
+    EXPECT_GE(statistics._properties_set, _options._participant_count * (_options._property_count + 1));
+}
+
+/**
+ * @detail Test that the batch writer of the participants saves round trips
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemBatched)
+{
+    _options._participant_count = 50;
+    _options._property_count = 20;
+    generateFiles("loopback_batched");
+
+    auto single_system = createSystem(test::LoopbackBehaviour());
+    ASSERT_NO_THROW(configureSystemProperties(*single_system, _files._system_properties_file, ConfigureOptions()));
+
+    test::LoopbackBehaviour batched_behaviour;
+    batched_behaviour._batch_writes = true;
+    auto batched_system = createSystem(batched_behaviour);
+    ASSERT_NO_THROW(configureSystemProperties(*batched_system, _files._system_properties_file, ConfigureOptions()));
+
+    const auto single_statistics = single_system->getStatistics();
+    const auto batched_statistics = batched_system->getStatistics();
+    EXPECT_EQ(batched_statistics._properties_set, single_statistics._properties_set);
+    EXPECT_LT(batched_statistics._round_trips, single_statistics._round_trips);
+    EXPECT_EQ(batched_system->getParticipant("participant_7")->getPropertyValue("generated/property_3"),
+              single_system->getParticipant("participant_7")->getPropertyValue("generated/property_3"));
+}
+
+/**
+ * @detail Test that refused properties are reported as error
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemPropertyRefused)
+{
+    _options._participant_count = 10;
+    test::LoopbackBehaviour behaviour;
+    behaviour._property_failure_rate = 1.0;
+    setUpSystem("loopback_refused", behaviour);
+
+    try
+    {
+        configureSystemProperties(*_system, _files._system_properties_file, ConfigureOptions());
+        FAIL() << "refused properties are not reported";
+    }
+    catch (const std::runtime_error& error)
+    {
+        EXPECT_NE(std::string(error.what()).find("Error setting property"), std::string::npos) << error.what();
+    }
+}
+
+/**
+ * @detail Test that refused system properties are not recorded as applied and are pushed again
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemIncrementalRefused)
+{
+    _options._participant_count = 20;
+    _options._property_count = 0;
+    _options._system_property_count = 5;
+    generateFiles("loopback_incremental_refused");
+    for (const bool batch_writes : { false, true })
+    {
+        test::LoopbackBehaviour behaviour;
+        behaviour._property_failure_rate = 0.3;
+        behaviour._batch_writes = batch_writes;
+        auto system = createSystem(behaviour);
+        AppliedProperties applied;
+        ConfigureOptions configure_options;
+        configure_options._applied_properties = &applied;
+        ASSERT_NO_THROW(configureSystemProperties(*system, _files._system_properties_file, configure_options));
+
+        size_t applied_count = 0;
+        for (size_t index = 0; index < _options._participant_count; ++index)
+        {
+            const auto name = test::getGeneratedParticipantName(index);
+            EXPECT_EQ(applied.getPropertyCount(name), system->getParticipant(name)->getPropertyCount()) << name;
+            applied_count += applied.getPropertyCount(name);
+        }
+        ASSERT_LT(applied_count, _options._participant_count * _options._system_property_count);
+
+        // only the refused properties are pushed again
+        const auto properties_set = system->getStatistics()._properties_set;
+        const auto properties_refused = system->getStatistics()._properties_refused;
+        ASSERT_NO_THROW(configureSystemProperties(*system, _files._system_properties_file, configure_options));
+        EXPECT_EQ(system->getStatistics()._properties_set - properties_set
+                      + system->getStatistics()._properties_refused - properties_refused,
+                  _options._participant_count * _options._system_property_count - applied_count);
+    }
+}
+
+/**
+ * @detail Test that unreachable participants are reported as error
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemUnreachable)
+{
+    _options._participant_count = 10;
+    test::LoopbackBehaviour behaviour;
+    behaviour._unreachable_rate = 1.0;
+    setUpSystem("loopback_unreachable", behaviour);
+
+    EXPECT_EQ(_system->getSystemState()._state, fep3::SystemAggregatedState::unreachable);
+    EXPECT_THROW(configureSystemProperties(*_system, _files._system_properties_file, ConfigureOptions()),
+                 std::runtime_error);
+}
+
+/**
+ * @detail Test that participants without properties to set are not contacted
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemPlanned)
+{
+    _options._participant_count = 10;
+    _options._property_count = 5;
+    _options._system_property_count = 0;
+    // most participants of the system have no entry within the properties file
+    setUpSystem("loopback_planned");
+    for (size_t index = 0; index < 90; ++index)
+    {
+        _system->add("not_configured_" + std::to_string(index));
+    }
+
+    ConfigurationPlan plan;
+    ConfigureOptions configure_options;
+    configure_options._plan = &plan;
+    configure_options._dry_run = true;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    ASSERT_EQ(plan._participants.size(), 100u);
+    EXPECT_EQ(getRoundTripCount(plan), 10u * (1u + 5u));
+    EXPECT_EQ(plan._participants.back()._round_trips, 0u);
+    // the dry run does not contact any participant
+    EXPECT_EQ(_system->getStatistics()._round_trips, 0u);
+    EXPECT_EQ(_system->getSystemState()._state, fep3::SystemAggregatedState::unloaded);
+
+    configure_options._dry_run = false;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    // the planned requests plus the load transition of every participant
+    EXPECT_EQ(_system->getStatistics()._round_trips, getRoundTripCount(plan) + 100u);
+    EXPECT_EQ(_system->getParticipant("not_configured_0")->getPropertyCount(), 0u);
+}
+
+/**
+ * @detail Test that a dry run plans the batched requests without creating any batch writer
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemDryRunBatched)
+{
+    _options._participant_count = 10;
+    _options._property_count = 5;
+    test::LoopbackBehaviour behaviour;
+    behaviour._batch_writes = true;
+    setUpSystem("loopback_planned_batched", behaviour);
+
+    ConfigurationPlan plan;
+    ConfigureOptions configure_options;
+    configure_options._plan = &plan;
+    configure_options._dry_run = true;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    ASSERT_EQ(plan._participants.size(), _options._participant_count);
+    for (const auto& planned : plan._participants)
+    {
+        EXPECT_TRUE(planned._batched) << planned._participant_name;
+    }
+    EXPECT_EQ(_system->getStatistics()._batch_writers, 0u);
+
+    configure_options._dry_run = false;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    EXPECT_EQ(_system->getStatistics()._batch_writers, _options._participant_count);
+}
+
+/**
+ * @detail Test that a participant planned as batched is replanned if it does not provide a batch writer
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemBatchWriterMissing)
+{
+    _options._participant_count = 10;
+    _options._property_count = 5;
+    test::LoopbackBehaviour behaviour;
+    behaviour._batch_writes = true;
+    setUpSystem("loopback_batch_writer_missing", behaviour);
+    const auto unbatched_participant = _system->getParticipant(test::getGeneratedParticipantName(3));
+    unbatched_participant->withdrawBatchWriter();
+
+    ConfigurationPlan plan;
+    ConfigureOptions configure_options;
+    configure_options._plan = &plan;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    ASSERT_EQ(plan._participants.size(), _options._participant_count);
+    EXPECT_FALSE(plan._participants[3]._batched);
+    EXPECT_EQ(plan._participants[3]._round_trips,
+              (1u + _options._system_property_count) + (1u + _options._property_count));
+    EXPECT_TRUE(plan._participants[4]._batched);
+    // the planned requests plus the load transition of every participant
+    EXPECT_EQ(_system->getStatistics()._round_trips, getRoundTripCount(plan) + _options._participant_count);
+    EXPECT_EQ(unbatched_participant->getPropertyCount(), _options._property_count + _options._system_property_count);
+}
+
+/**
+ * @detail Test the configuration in waves of equal init priority
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemPriorityWaves)
+{
+    _options._participant_count = 200;
+    _options._property_count = 5;
+    _options._priority_levels = 4;
+    setUpSystem("loopback_waves");
+
+    std::mutex configured_mutex;
+    std::vector<int32_t> configured_priorities;
+    ConfigurationPlan plan;
+    ConfigureOptions configure_options;
+    configure_options._worker_count = 8;
+    configure_options._priority_waves = true;
+    configure_options._plan = &plan;
+    configure_options._progress_callback = [&](ProgressStage stage, const std::string& participant_name)
+    {
+        if (stage == ProgressStage::configured)
+        {
+            std::lock_guard<std::mutex> lock(configured_mutex);
+            configured_priorities.push_back(_system->getParticipant(participant_name)->getInitPriority());
+        }
+    };
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+
+    EXPECT_EQ(plan._wave_count, 4u);
+    EXPECT_EQ(plan._participants[3]._wave, 0u);
+    EXPECT_EQ(plan._participants[0]._wave, 3u);
+    // the highest init priority first, a wave only starts once the previous one is configured
+    ASSERT_EQ(configured_priorities.size(), _options._participant_count);
+    EXPECT_TRUE(std::is_sorted(configured_priorities.rbegin(), configured_priorities.rend()));
+    EXPECT_EQ(configured_priorities.front(), 3);
+    EXPECT_EQ(configured_priorities.back(), 0);
+}
+
+/**
+ * @detail Test that all refused properties are collected and can be retried
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemCollectFailures)
+{
+    _options._participant_count = 100;
+    _options._property_count = 10;
+    _options._system_property_count = 0;
+    test::LoopbackBehaviour behaviour;
+    behaviour._property_failure_rate = 0.2;
+    behaviour._seed = 7;
+    setUpSystem("loopback_collect", behaviour);
+
+    ConfigurationReport report;
+    ConfigureOptions configure_options;
+    configure_options._worker_count = 4;
+    configure_options._report = &report;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    ASSERT_FALSE(report._failures.empty());
+    EXPECT_EQ(report._failures.size(), _system->getStatistics()._properties_refused);
+    for (const auto& failure : report._failures)
+    {
+        EXPECT_EQ(failure._step, ConfigurationStep::property);
+        EXPECT_FALSE(failure._participant_name.empty());
+        EXPECT_FALSE(failure._property_name.empty());
+        EXPECT_FALSE(failure._type.empty());
+        EXPECT_FALSE(failure._value.empty());
+        EXPECT_FALSE(failure._reason.empty());
+    }
+
+    // every retry only sets the failed properties
+    configure_options._retry_report = &report;
+    for (size_t retry = 0; retry < 20 && !report._failures.empty(); ++retry)
+    {
+        const auto failed_count = report._failures.size();
+        const auto statistics_before = _system->getStatistics();
+        ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+        const auto statistics_after = _system->getStatistics();
+        EXPECT_EQ(statistics_after._properties_set + statistics_after._properties_refused
+                  - statistics_before._properties_set - statistics_before._properties_refused, failed_count);
+    }
+    ASSERT_TRUE(report._failures.empty());
+    for (size_t index = 0; index < _options._participant_count; ++index)
+    {
+        EXPECT_EQ(_system->getParticipant(test::getGeneratedParticipantName(index))->getPropertyCount(),
+                  _options._property_count);
+    }
+}
+
+/**
+ * @detail Test that the reachable participants are configured although others are unreachable
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemCollectUnreachable)
+{
+    _options._participant_count = 50;
+    _options._property_count = 3;
+    test::LoopbackBehaviour behaviour;
+    behaviour._unreachable_rate = 0.2;
+    behaviour._seed = 3;
+    setUpSystem("loopback_collect_unreachable", behaviour);
+
+    ConfigurationReport report;
+    ConfigureOptions configure_options;
+    configure_options._report = &report;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    ASSERT_FALSE(report._failures.empty());
+    EXPECT_EQ(report._failures.front()._step, ConfigurationStep::system_state);
+    for (size_t index = 0; index < _options._participant_count; ++index)
+    {
+        const auto participant = _system->getParticipant(test::getGeneratedParticipantName(index));
+        const auto failed_count = std::count_if(report._failures.begin(), report._failures.end(),
+            [&participant](const ConfigurationFailure& failure)
+            {
+                return failure._participant_name == participant->getName();
+            });
+        if (participant->isReachable())
+        {
+            EXPECT_EQ(failed_count, 0);
+            EXPECT_EQ(participant->getPropertyCount(), _options._property_count + _options._system_property_count);
+        }
+        else
+        {
+            // every property to set is reported
+            EXPECT_EQ(static_cast<size_t>(failed_count), _options._property_count + _options._system_property_count);
+        }
+    }
+}
+
+/**
+ * @detail Test that every participant is loaded right before it is configured
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemLoadParticipants)
+{
+    _options._participant_count = 50;
+    _options._property_count = 3;
+    test::LoopbackBehaviour behaviour;
+    behaviour._unreachable_rate = 0.2;
+    behaviour._seed = 3;
+    setUpSystem("loopback_load_participants", behaviour);
+
+    ConfigurationReport report;
+    ConfigureOptions configure_options;
+    configure_options._worker_count = 4;
+    configure_options._load_participants = true;
+    configure_options._report = &report;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    ASSERT_FALSE(report._failures.empty());
+    for (size_t index = 0; index < _options._participant_count; ++index)
+    {
+        const auto participant = _system->getParticipant(test::getGeneratedParticipantName(index));
+        std::vector<ConfigurationFailure> failures;
+        std::copy_if(report._failures.begin(), report._failures.end(), std::back_inserter(failures),
+            [&participant](const ConfigurationFailure& failure)
+            {
+                return failure._participant_name == participant->getName();
+            });
+        if (participant->isReachable())
+        {
+            // the unreachable participants do not keep the others from being loaded
+            EXPECT_TRUE(failures.empty());
+            EXPECT_EQ(participant->getState(), fep3::rpc::IRPCParticipantStateMachine::State::loaded);
+            EXPECT_EQ(participant->getPropertyCount(), _options._property_count + _options._system_property_count);
+        }
+        else
+        {
+            // the failed load and every property to set is reported
+            ASSERT_EQ(failures.size(), 1 + _options._property_count + _options._system_property_count);
+            EXPECT_EQ(failures.front()._step, ConfigurationStep::system_state);
+        }
+    }
+}
+
+/**
+ * @detail Test that a changed value of a watched properties file is pushed to its participant only
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testWatchLoopbackSystemProperties)
+{
+    _options._participant_count = 100;
+    _options._property_count = 5;
+    _options._property_type_mix = { 0, 0, 0, 1 };
+    setUpSystem("loopback_watch");
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, ConfigureOptions()));
+
+    std::mutex reload_mutex;
+    std::condition_variable reload_condition;
+    std::vector<std::string> reload_errors;
+    WatchOptions watch_options;
+    watch_options._debounce = std::chrono::milliseconds(50);
+    watch_options._reload_callback = [&](const std::string& error_message)
+    {
+        std::lock_guard<std::mutex> lock(reload_mutex);
+        reload_errors.push_back(error_message);
+        reload_condition.notify_all();
+    };
+    PropertiesWatcher watcher(*_system, _files._system_properties_file, watch_options);
+    const auto properties_set = _system->getStatistics()._properties_set;
+
+    // change the first property of participant_7
+    std::stringstream content_stream;
+    content_stream << std::ifstream(_files._system_properties_file).rdbuf();
+    auto content = content_stream.str();
+    const auto value_begin = content.find("<value>", content.find("<id>participant_7</id>")) + 7;
+    const auto value_end = content.find("</value>", value_begin);
+    content.replace(value_begin, value_end - value_begin, "changed_value");
+    std::ofstream(_files._system_properties_file, std::ios::trunc) << content;
+
+    {
+        std::unique_lock<std::mutex> lock(reload_mutex);
+        ASSERT_TRUE(reload_condition.wait_for(lock, std::chrono::seconds(10), [&]() { return !reload_errors.empty(); }));
+        EXPECT_EQ(reload_errors.front(), "");
+    }
+    watcher.stop();
+    EXPECT_GE(watcher.getReloadCount(), 1u);
+
+    const auto generated_properties = test::getGeneratedProperties(_options);
+    EXPECT_EQ(_system->getParticipant("participant_7")->getPropertyValue(generated_properties.front()._name), "changed_value");
+    EXPECT_EQ(_system->getStatistics()._properties_set, properties_set + 1);
+}
+
+/**
+ * @detail Test that transiently failing requests are retried
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemRetry)
+{
+    _options._participant_count = 20;
+    _options._property_count = 10;
+    test::LoopbackBehaviour behaviour;
+    behaviour._transient_failure_rate = 0.1;
+    behaviour._seed = 11;
+    setUpSystem("loopback_retry", behaviour);
+
+    auto failing_system = createSystem(behaviour);
+    EXPECT_THROW(configureSystemProperties(*failing_system, _files._system_properties_file, ConfigureOptions()),
+                 std::runtime_error);
+
+    ConfigureOptions configure_options;
+    configure_options._worker_count = 4;
+    configure_options._retry._max_retries = 10;
+    configure_options._retry._initial_backoff = std::chrono::milliseconds(1);
+    configure_options._retry._max_backoff = std::chrono::milliseconds(4);
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    for (size_t index = 0; index < _options._participant_count; ++index)
+    {
+        EXPECT_EQ(_system->getParticipant(test::getGeneratedParticipantName(index))->getPropertyCount(),
+                  _options._property_count + _options._system_property_count);
+    }
+    // the configuration service a request failed on is not reused
+    EXPECT_GT(_system->getStatistics()._configuration_drops, 0u);
+}
+
+/**
+ * @detail Test that a stalled participant does not hold up the others beyond its deadline
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemParticipantDeadline)
+{
+    _options._participant_count = 20;
+    _options._property_count = 10;
+    setUpSystem("loopback_participant_deadline");
+    const auto stalled_participant = _system->getParticipant(test::getGeneratedParticipantName(5));
+    stalled_participant->stallConfiguration();
+
+    ConfigurationReport report;
+    ConfigureOptions configure_options;
+    configure_options._worker_count = 4;
+    configure_options._report = &report;
+    configure_options._deadlines._participant_deadline = std::chrono::milliseconds(100);
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    stalled_participant->releaseConfiguration();
+
+    // the loading is not limited, only the requests of the stalled participant are failed
+    ASSERT_FALSE(report._failures.empty());
+    for (const auto& failure : report._failures)
+    {
+        EXPECT_EQ(failure._participant_name, stalled_participant->getName());
+        EXPECT_NE(failure._reason.find("deadline"), std::string::npos) << failure._reason;
+    }
+    // the stalled request is abandoned, the deadline has expired before the next one
+    EXPECT_EQ(stalled_participant->getStatistics()._stalled_requests, 1u);
+    EXPECT_EQ(stalled_participant->getPropertyCount(), 0u);
+    EXPECT_EQ(_system->getParticipant(test::getGeneratedParticipantName(6))->getPropertyCount(),
+              _options._property_count + _options._system_property_count);
+}
+
+/**
+ * @detail Test the deadline of the whole configuration
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemOperationDeadline)
+{
+    _options._participant_count = 50;
+    _options._property_count = 10;
+    setUpSystem("loopback_operation_deadline");
+    const auto stalled_participant = _system->getParticipant(test::getGeneratedParticipantName(10));
+    stalled_participant->stallConfiguration();
+
+    // without the operation deadline the configuration would wait for the stalled participant forever
+    ConfigureOptions configure_options;
+    configure_options._deadlines._operation_deadline = std::chrono::milliseconds(200);
+    EXPECT_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options),
+                 DeadlineExceededError);
+    stalled_participant->releaseConfiguration();
+    EXPECT_EQ(stalled_participant->getStatistics()._stalled_requests, 1u);
+}
+
+/**
+ * @detail Test that a request not returning within its deadline is abandoned and not sent again
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemRequestDeadline)
+{
+    _options._participant_count = 5;
+    _options._property_count = 5;
+    setUpSystem("loopback_request_deadline");
+    const auto stalled_participant = _system->getParticipant(test::getGeneratedParticipantName(2));
+    stalled_participant->stallConfiguration();
+
+    ConfigurationReport report;
+    ConfigureOptions configure_options;
+    configure_options._report = &report;
+    configure_options._deadlines._request_deadline = std::chrono::milliseconds(10);
+    configure_options._retry._max_retries = 3;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+    stalled_participant->releaseConfiguration();
+
+    ASSERT_FALSE(report._failures.empty());
+    for (const auto& failure : report._failures)
+    {
+        EXPECT_EQ(failure._participant_name, stalled_participant->getName());
+        EXPECT_NE(failure._reason.find("abandoned"), std::string::npos) << failure._reason;
+    }
+    // one abandoned request per node, none of them is retried
+    EXPECT_EQ(stalled_participant->getStatistics()._stalled_requests, 2u);
+    EXPECT_EQ(stalled_participant->getPropertyCount(), 0u);
+    EXPECT_EQ(_system->getParticipant(test::getGeneratedParticipantName(3))->getPropertyCount(),
+              _options._property_count + _options._system_property_count);
+}
+
+/**
+ * @detail Test that the same behaviour injects the same failures
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testLoopbackSystemDeterministic)
+{
+    test::LoopbackBehaviour behaviour;
+    behaviour._unreachable_rate = 0.5;
+    behaviour._seed = 42;
+    test::LoopbackSystem first_system("first", behaviour);
+    test::LoopbackSystem second_system("second", behaviour);
+    size_t unreachable_count = 0;
+    for (size_t index = 0; index < 100; ++index)
+    {
+        const auto name = test::getGeneratedParticipantName(index);
+        const auto first_participant = first_system.add(name);
+        EXPECT_EQ(first_participant->isReachable(), second_system.add(name)->isReachable());
+        unreachable_count += first_participant->isReachable() ? 0 : 1;
+    }
+    EXPECT_GT(unreachable_count, 0u);
+    EXPECT_LT(unreachable_count, 100u);
+}
+
+/**
+ * @detail Test the broadcast of the system properties and the report of the participants missing them
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemBroadcast)
+{
+    _options._participant_count = 100;
+    _options._property_count = 5;
+    _options._system_property_count = 10;
+    _options._priority_levels = 4;
+    test::LoopbackBehaviour behaviour;
+    behaviour._batch_writes = true;
+    behaviour._property_failure_rate = 0.02;
+    behaviour._seed = 7;
+    setUpSystem("loopback_broadcast", behaviour);
+
+    // the participants reported as missing the system properties are exactly the incomplete ones
+    auto expect_missing_reported = [this](test::LoopbackSystem& configured_system, const ConfigurationReport& report)
+    {
+        const auto missing = getParticipantsMissingSystemProperties(report);
+        EXPECT_FALSE(missing.empty());
+        for (size_t index = 0; index < _options._participant_count; ++index)
+        {
+            const auto participant = configured_system.getParticipant(test::getGeneratedParticipantName(index));
+            bool complete = true;
+            for (size_t property = 0; property < _options._system_property_count; ++property)
+            {
+                complete = complete
+                    && !participant->getPropertyValue("system/system_property_" + std::to_string(property)).empty();
+            }
+            EXPECT_EQ(complete, std::find(missing.begin(), missing.end(), participant->getName()) == missing.end())
+                << participant->getName();
+        }
+    };
+
+    ConfigurationReport report;
+    ConfigurationPlan plan;
+    ConfigureOptions configure_options;
+    configure_options._worker_count = 8;
+    configure_options._priority_waves = true;
+    configure_options._broadcast_system_properties = true;
+    configure_options._report = &report;
+    configure_options._plan = &plan;
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, configure_options));
+
+    // serialized once, sent within one request per participant, wave by wave
+    EXPECT_EQ(_system->getStatistics()._serializations, 1u);
+    EXPECT_EQ(plan._wave_count, _options._priority_levels);
+    for (const auto& planned : plan._participants)
+    {
+        EXPECT_TRUE(planned._broadcast) << planned._participant_name;
+    }
+    expect_missing_reported(*_system, report);
+
+    // a participant without batch writer fails on a refused system property as well
+    test::LoopbackBehaviour single_behaviour = behaviour;
+    single_behaviour._batch_writes = false;
+    auto single_system = createSystem(single_behaviour);
+    ConfigurationReport single_report;
+    configure_options._report = &single_report;
+    ASSERT_NO_THROW(configureSystemProperties(*single_system, _files._system_properties_file, configure_options));
+    EXPECT_EQ(single_system->getStatistics()._serializations, 0u);
+    expect_missing_reported(*single_system, single_report);
+
+    // as long as nothing is recorded, the incremental configuration broadcasts as well
+    auto incremental_system = createSystem(behaviour);
+    AppliedProperties applied;
+    ConfigurationReport incremental_report;
+    configure_options._report = &incremental_report;
+    configure_options._applied_properties = &applied;
+    ASSERT_NO_THROW(configureSystemProperties(*incremental_system, _files._system_properties_file, configure_options));
+    EXPECT_EQ(incremental_system->getStatistics()._serializations, 1u);
+    expect_missing_reported(*incremental_system, incremental_report);
+    ASSERT_NO_THROW(configureSystemProperties(*incremental_system, _files._system_properties_file, configure_options));
+    EXPECT_EQ(incremental_system->getStatistics()._serializations, 1u);
+    configure_options._applied_properties = nullptr;
+
+    // without a report the first participant missing them fails the configuration
+    auto failing_system = createSystem(behaviour);
+    configure_options._report = nullptr;
+    EXPECT_THROW(configureSystemProperties(*failing_system, _files._system_properties_file, configure_options),
+                 std::runtime_error);
+}
+
+/**
+ * @detail Test stepping through a parameter sweep by overlays of a base properties file
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testApplyLoopbackPropertyOverlay)
+{
+    _options._participant_count = 200;
+    _options._property_count = 10;
+    setUpSystem("loopback_overlay");
+    const auto property_name = test::getGeneratedProperties(_options).front()._name;
+    const auto participant_3 = _system->getParticipant(test::getGeneratedParticipantName(3));
+    const auto participant_7 = _system->getParticipant(test::getGeneratedParticipantName(7));
+
+    AppliedProperties applied;
+    ConfigureOptions configure_options;
+    configure_options._applied_properties = &applied;
+    ASSERT_NO_THROW(applyPropertyOverlay(*_system, _files._system_properties_file, PropertyOverlay(), configure_options));
+    const auto base_value_3 = participant_3->getPropertyValue(property_name);
+    ASSERT_FALSE(base_value_3.empty());
+
+    // a step only contacts the participants whose properties differ from the previous step
+    PropertyOverlay first_step;
+    first_step._overrides.push_back({ participant_3->getName(), property_name, "", "4711" });
+    first_step._overrides.push_back({ participant_3->getName(), "sweep/added", "int", "1" });
+    auto round_trips = _system->getStatistics()._round_trips;
+    ASSERT_NO_THROW(applyPropertyOverlay(*_system, _files._system_properties_file, first_step, configure_options));
+    EXPECT_LE(_system->getStatistics()._round_trips - round_trips, 4u);
+    EXPECT_EQ(participant_3->getPropertyValue(property_name), "4711");
+    EXPECT_EQ(participant_3->getPropertyValue("sweep/added"), "1");
+
+    PropertyOverlay second_step;
+    second_step._overrides.push_back({ participant_7->getName(), property_name, "", "42" });
+    second_step._overrides.push_back({ participant_7->getName(), property_name, "", "43" });
+    round_trips = _system->getStatistics()._round_trips;
+    ASSERT_NO_THROW(applyPropertyOverlay(*_system, _files._system_properties_file, second_step, configure_options));
+    EXPECT_LE(_system->getStatistics()._round_trips - round_trips, 6u);
+    EXPECT_EQ(participant_3->getPropertyValue(property_name), base_value_3);
+    EXPECT_EQ(participant_7->getPropertyValue(property_name), "43");
+
+    // an added property needs a type
+    PropertyOverlay untyped_step;
+    untyped_step._overrides.push_back({ participant_7->getName(), "sweep/untyped", "", "1" });
+    EXPECT_THROW(applyPropertyOverlay(*_system, _files._system_properties_file, untyped_step, configure_options),
+                 std::runtime_error);
+}
+
+/**
+ * @detail Test the configuration from a snapshot of the system properties
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testConfigureLoopbackSystemSnapshot)
+{
+    _options._participant_count = 50;
+    _options._property_count = 10;
+    _options._timing_configuration_type = "Timing3AFAP";
+    setUpSystem("loopback_snapshot");
+    const auto snapshot_file = _files._system_properties_file + "." + snapshot_file_extension;
+    ASSERT_NO_THROW(convertSystemPropertiesToSnapshot(_files._system_properties_file, snapshot_file));
+
+    auto expected_system = createSystem(test::LoopbackBehaviour());
+    ASSERT_NO_THROW(configureSystemProperties(*expected_system, _files._system_properties_file, ConfigureOptions()));
+    ASSERT_NO_THROW(configureSystemProperties(*_system, snapshot_file, ConfigureOptions()));
+
+    EXPECT_EQ(_system->getTimingConfiguration(), expected_system->getTimingConfiguration());
+    EXPECT_EQ(_system->getStatistics()._properties_set, expected_system->getStatistics()._properties_set);
+    for (size_t index = 0; index < _options._participant_count; ++index)
+    {
+        const auto name = test::getGeneratedParticipantName(index);
+        for (const auto& property : test::getGeneratedProperties(_options))
+        {
+            EXPECT_EQ(_system->getParticipant(name)->getPropertyValue(property._name),
+                      expected_system->getParticipant(name)->getPropertyValue(property._name)) << name;
+        }
+    }
+
+    // a corrupted snapshot is refused before any participant is contacted
+    {
+        std::fstream snapshot(snapshot_file, std::ios::in | std::ios::out | std::ios::binary);
+        snapshot.seekp(-1, std::ios::end);
+        snapshot.put('\x7f');
+    }
+    // the modification time might not have changed within its resolution
+    invalidateDescriptionCache(snapshot_file);
+    auto corrupted_system = createSystem(test::LoopbackBehaviour());
+    EXPECT_THROW(configureSystemProperties(*corrupted_system, snapshot_file, ConfigureOptions()), std::runtime_error);
+    EXPECT_EQ(corrupted_system->getStatistics()._round_trips, 0u);
+}
+
+/**
+ * @detail Test the export of the properties of a running system and the configuration from the exported file
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibLoopback, testExportLoopbackSystemProperties)
+{
+    _options._participant_count = 40;
+    _options._property_count = 10;
+    _options._system_property_count = 3;
+    setUpSystem("loopback_export");
+    ASSERT_NO_THROW(configureSystemProperties(*_system, _files._system_properties_file, ConfigureOptions()));
+    // one participant deviates from the system properties of the others
+    const auto deviating_name = test::getGeneratedParticipantName(7);
+    ASSERT_TRUE(_system->getParticipant(deviating_name)->setPropertyValue("system/system_property_1", "4711", "int"));
+
+    ExportOptions export_options;
+    export_options._worker_count = 8;
+    const auto exported_file = _files._system_properties_file + ".exported.fep_system_properties";
+    const auto exported_snapshot = _files._system_properties_file + ".exported." + snapshot_file_extension;
+    ASSERT_NO_THROW(exportSystemProperties(*_system, exported_file, export_options));
+    ASSERT_NO_THROW(exportSystemProperties(*_system, exported_snapshot, export_options));
+
+    for (const auto& file : { exported_file, exported_snapshot })
+    {
+        auto restored_system = createSystem(test::LoopbackBehaviour());
+        ASSERT_NO_THROW(configureSystemProperties(*restored_system, file, ConfigureOptions())) << file;
+        for (size_t index = 0; index < _options._participant_count; ++index)
+        {
+            const auto name = test::getGeneratedParticipantName(index);
+            const auto participant = _system->getParticipant(name);
+            const auto restored_participant = restored_system->getParticipant(name);
+            EXPECT_EQ(restored_participant->getPropertyCount(), participant->getPropertyCount()) << name;
+            for (const auto& property : participant->getProperties(""))
+            {
+                EXPECT_EQ(restored_participant->getPropertyValue(property.first), property.second.second)
+                    << name << " " << property.first;
+                EXPECT_EQ(restored_participant->getPropertyType(property.first), property.second.first)
+                    << name << " " << property.first;
+            }
+        }
+        EXPECT_EQ(restored_system->getParticipant(deviating_name)->getPropertyValue("system/system_property_1"), "4711");
+    }
+
+    // an unreachable participant is recorded and left out
+    test::LoopbackBehaviour unreachable_behaviour;
+    unreachable_behaviour._unreachable_rate = 0.2;
+    auto unreachable_system = createSystem(unreachable_behaviour);
+    size_t unreachable_count = 0;
+    for (size_t index = 0; index < _options._participant_count; ++index)
+    {
+        if (!unreachable_system->getParticipant(test::getGeneratedParticipantName(index))->isReachable())
+        {
+            ++unreachable_count;
+        }
+    }
+    ASSERT_GT(unreachable_count, 0u);
+    ConfigurationReport configure_report;
+    ConfigureOptions configure_options;
+    configure_options._report = &configure_report;
+    ASSERT_NO_THROW(configureSystemProperties(*unreachable_system, _files._system_properties_file, configure_options));
+    const auto partial_file = _files._system_properties_file + ".partial.fep_system_properties";
+    std::remove(partial_file.c_str());
+    EXPECT_THROW(exportSystemProperties(*unreachable_system, partial_file, export_options), std::runtime_error);
+    EXPECT_FALSE(std::ifstream(partial_file).is_open());
+    ConfigurationReport report;
+    export_options._report = &report;
+    ASSERT_NO_THROW(exportSystemProperties(*unreachable_system, partial_file, export_options));
+    EXPECT_EQ(report._system_name, _options._system_name);
+    EXPECT_EQ(report._failures.size(), unreachable_count);
+    auto restored_system = createSystem(test::LoopbackBehaviour());
+    ASSERT_NO_THROW(configureSystemProperties(*restored_system, partial_file, ConfigureOptions()));
+    for (size_t index = 0; index < _options._participant_count; ++index)
+    {
+        const auto name = test::getGeneratedParticipantName(index);
+        // the participants left out only get the system properties
+        const auto participant = unreachable_system->getParticipant(name);
+        EXPECT_EQ(restored_system->getParticipant(name)->getPropertyCount(),
+                  participant->isReachable() ? participant->getPropertyCount() : _options._system_property_count) << name;
+    }
+
+    // a failed export keeps the file it would have replaced and the files next to it
+    export_options._report = nullptr;
+    for (const auto& file : { partial_file, exported_snapshot })
+    {
+        std::ofstream(file + ".tmp") << "not written by the export";
+        std::ostringstream previous_content;
+        previous_content << std::ifstream(file, std::ios::binary).rdbuf();
+        EXPECT_THROW(exportSystemProperties(*unreachable_system, file, export_options), std::runtime_error) << file;
+        std::ostringstream content;
+        content << std::ifstream(file, std::ios::binary).rdbuf();
+        EXPECT_EQ(content.str(), previous_content.str()) << file;
+        std::ostringstream other_content;
+        other_content << std::ifstream(file + ".tmp").rdbuf();
+        EXPECT_EQ(other_content.str(), "not written by the export") << file;
+    }
+}
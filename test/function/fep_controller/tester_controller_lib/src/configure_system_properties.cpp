@@ -41,6 +41,9 @@
 #include <fep3/components/scheduler/scheduler_service_intf.h>
 #include "fep_test_common.h"
 
+#include <atomic>
+#include <map>
+#include <sstream>
 #include <string>
 #include <memory>
 
@@ -64,6 +67,38 @@ public:
     }
 };
 
+/**
+ * Batch writer forwarding to the configuration RPC service, counting the batches
+ */
+class TestBatchWriter : public fep3::controller::IPropertyBatchWriter
+{
+public:
+    TestBatchWriter(fep3::ParticipantProxy participant, std::atomic<size_t>& batch_count)
+        : _participant(participant), _batch_count(batch_count)
+    {
+    }
+
+    std::vector<fep3::controller::PropertyWriteError> setProperties(const std::string& node_path,
+        const std::vector<fep3::controller::PropertyAssignment>& properties) override
+    {
+        ++_batch_count;
+        std::vector<fep3::controller::PropertyWriteError> errors;
+        auto node = _participant.getRPCComponentProxyByIID<fep3::rpc::IRPCConfiguration>()->getProperties(node_path);
+        for (size_t index = 0; index < properties.size(); ++index)
+        {
+            if (!node || !node->setProperty(properties[index]._name, properties[index]._value, properties[index]._type))
+            {
+                errors.push_back({ index, "refused" });
+            }
+        }
+        return errors;
+    }
+
+private:
+    fep3::ParticipantProxy _participant;
+    std::atomic<size_t>& _batch_count;
+};
+
 class TesterControllerLibProperties : public ::testing::Test
 {
 protected:
@@ -141,6 +176,283 @@ TEST_F(TesterControllerLibProperties, testConfigureSystem)
     EXPECT_EQ(props_part2->getProperty("system/system_parameter"), "42");
 }
 
+/**
+ * @brief Test whether the participants may be configured concurrently
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemParallel)
+{
+    test_file_properties.append("files/2_participants.fep_system_properties");
+    controller::ConfigureOptions options;
+    options._worker_count = 2;
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties, options));
+    ASSERT_TRUE(setupPropertiesInterfaces());
+
+    EXPECT_EQ(a_util::strings::toDouble(props_part1->getProperty("test_config/pos1")), a_util::strings::toDouble("1.234"));
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "3");
+    EXPECT_EQ(props_part1->getProperty("test_config/pos_X"), "11");
+    EXPECT_EQ(props_part1->getProperty("system/system_parameter"), "42");
+
+    EXPECT_EQ(props_part2->getProperty("test_config/parameter1"), "1");
+    EXPECT_EQ(props_part2->getProperty("test_config/pos_X"), "100");
+    EXPECT_EQ(props_part2->getProperty("system/system_parameter"), "42");
+
+    // timing is configured after all participants
+    EXPECT_EQ(props_part1->getProperty(FEP3_CLOCKSYNC_SERVICE_CONFIG_TIMING_MASTER), "participant2");
+    EXPECT_EQ(props_part2->getProperty(FEP3_CLOCKSYNC_SERVICE_CONFIG_TIMING_MASTER), "participant2");
+}
+
+/**
+ * @brief Test whether an error of a participant is reported when configuring concurrently
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemParallelInvalidPropertyFormat)
+{
+    test_file_properties.append("files/invalid_property_format.fep_system_properties");
+    controller::ConfigureOptions options;
+    options._worker_count = 4;
+
+    try
+    {
+        fep3::controller::configureSystemProperties(*system_to_test, test_file_properties, options);
+        FAIL() << "Expected std::runtime_error";
+    }
+    catch (std::runtime_error const & err)
+    {
+        std::string error_what = err.what();
+        EXPECT_NE(error_what.find(std::string("Error setting property 'test_config.parameter1' of participant 'participant1'.")), std::string::npos);
+    }
+    catch (...)
+    {
+        FAIL() << "Expected std::runtime_error";
+    }
+}
+
+/**
+ * @brief Test whether the properties of a participant are set by one batch per property node
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemBatched)
+{
+    test_file_properties.append("files/2_participants.fep_system_properties");
+    std::atomic<size_t> batch_count{ 0 };
+    controller::ConfigureOptions options;
+    options._batch_writer_factory = [&batch_count](fep3::ParticipantProxy& participant)
+    {
+        return std::make_shared<TestBatchWriter>(participant, batch_count);
+    };
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties, options));
+    ASSERT_TRUE(setupPropertiesInterfaces());
+
+    // one batch for the system properties and one for the element properties of each participant
+    EXPECT_EQ(batch_count, 4u);
+    EXPECT_EQ(props_part1->getProperty("test_config/string_test"), "this is a string");
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "3");
+    EXPECT_EQ(props_part1->getProperty("system/system_parameter"), "42");
+    EXPECT_EQ(props_part2->getProperty("test_config/pos_X"), "100");
+    EXPECT_EQ(props_part2->getProperty("system/system_parameter"), "42");
+}
+
+/**
+ * @brief Test whether participants without batch support are configured property by property
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemBatchedFallback)
+{
+    test_file_properties.append("files/2_participants.fep_system_properties");
+    std::atomic<size_t> batch_count{ 0 };
+    controller::ConfigureOptions options;
+    options._batch_writer_factory = [&](fep3::ParticipantProxy& participant)
+    {
+        return participant.getName() == part_name_1
+            ? std::make_shared<TestBatchWriter>(participant, batch_count)
+            : std::shared_ptr<TestBatchWriter>();
+    };
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties, options));
+    ASSERT_TRUE(setupPropertiesInterfaces());
+
+    EXPECT_EQ(batch_count, 2u);
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "3");
+    EXPECT_EQ(props_part2->getProperty("test_config/pos_X"), "100");
+    EXPECT_EQ(props_part2->getProperty("system/system_parameter"), "42");
+}
+
+/**
+ * @brief Test whether refused properties of a batch are reported
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemBatchedInvalidPropertyFormat)
+{
+    test_file_properties.append("files/invalid_property_format.fep_system_properties");
+    std::atomic<size_t> batch_count{ 0 };
+    controller::ConfigureOptions options;
+    options._batch_writer_factory = [&batch_count](fep3::ParticipantProxy& participant)
+    {
+        return std::make_shared<TestBatchWriter>(participant, batch_count);
+    };
+
+    try
+    {
+        fep3::controller::configureSystemProperties(*system_to_test, test_file_properties, options);
+        FAIL() << "Expected std::runtime_error";
+    }
+    catch (std::runtime_error const & err)
+    {
+        std::string error_what = err.what();
+        EXPECT_NE(error_what.find(std::string("Error setting property 'test_config.parameter1' of participant 'participant1'.")), std::string::npos);
+    }
+    catch (...)
+    {
+        FAIL() << "Expected std::runtime_error";
+    }
+}
+
+/**
+ * @brief Test whether only changed properties are pushed when reconfiguring incrementally
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemIncremental)
+{
+    test_file_properties.append("files/2_participants.fep_system_properties");
+    controller::AppliedProperties applied_properties;
+    controller::ConfigureOptions options;
+    options._applied_properties = &applied_properties;
+
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties, options));
+    ASSERT_TRUE(setupPropertiesInterfaces());
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "3");
+    // 1 system property and 5 participant properties
+    EXPECT_EQ(applied_properties.getPropertyCount(part_name_1), 6u);
+    EXPECT_EQ(applied_properties.getPropertyCount(part_name_2), 2u);
+
+    // change the value behind the back of the controller, reapplying the same file must not touch it
+    ASSERT_TRUE(props_part1->setProperty("test_config/parameter1", "7", "int"));
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties, options));
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "7");
+
+    // after forgetting the participant its properties are pushed again
+    applied_properties.clear(part_name_1);
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties, options));
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "3");
+}
+
+/**
+ * @detail Test the asynchronous configuration with progress reporting
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemAsync)
+{
+    test_file_properties.append("files/2_participants.fep_system_properties");
+    std::map<controller::ProgressStage, std::vector<std::string>> reported;
+    controller::ConfigureOptions options;
+    options._worker_count = 2;
+    options._progress_callback = [&reported](controller::ProgressStage stage, const std::string& participant_name)
+    {
+        reported[stage].push_back(participant_name);
+    };
+
+    auto configuring = controller::configureSystemPropertiesAsync(*system_to_test, test_file_properties, options);
+    ASSERT_NO_THROW(configuring.get());
+    ASSERT_TRUE(setupPropertiesInterfaces());
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "3");
+    EXPECT_EQ(props_part2->getProperty("test_config/parameter1"), "1");
+
+    EXPECT_EQ(reported[controller::ProgressStage::parsed].size(), 1u);
+    EXPECT_EQ(reported[controller::ProgressStage::loaded].size(), 2u);
+    EXPECT_EQ(reported[controller::ProgressStage::configured].size(), 2u);
+    EXPECT_EQ(reported[controller::ProgressStage::timing_applied].size(), 2u);
+}
+
+/**
+ * @detail Test the cancellation of the configuration
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemCancelled)
+{
+    test_file_properties.append("files/2_participants.fep_system_properties");
+    controller::CancellationToken cancellation_token;
+    size_t configured_count = 0;
+    size_t timing_applied_count = 0;
+    controller::ConfigureOptions options;
+    options._cancellation_token = cancellation_token;
+    // cancel as soon as the first participant is configured
+    options._progress_callback = [&](controller::ProgressStage stage, const std::string&)
+    {
+        if (stage == controller::ProgressStage::configured)
+        {
+            ++configured_count;
+            cancellation_token.cancel();
+        }
+        else if (stage == controller::ProgressStage::timing_applied)
+        {
+            ++timing_applied_count;
+        }
+    };
+
+    auto configuring = controller::configureSystemPropertiesAsync(*system_to_test, test_file_properties, options);
+    EXPECT_THROW(configuring.get(), controller::OperationCancelledError);
+    EXPECT_EQ(configured_count, 1u);
+    EXPECT_EQ(timing_applied_count, 0u);
+}
+
+/**
+ * @detail Test the tracing of the configuration phases
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemTracing)
+{
+    test_file_properties.append("files/2_participants.fep_system_properties");
+    controller::invalidateDescriptionCache();
+    auto trace_writer = std::make_shared<controller::ChromeTraceWriter>();
+    controller::setTraceSink(trace_writer);
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties));
+    controller::setTraceSink(nullptr);
+
+    std::ostringstream trace;
+    trace_writer->write(trace);
+    const auto trace_json = trace.str();
+    EXPECT_NE(trace_json.find("\"name\":\"dom.load\""), std::string::npos);
+    EXPECT_NE(trace_json.find("\"name\":\"internalReadConfig\""), std::string::npos);
+    EXPECT_NE(trace_json.find("\"name\":\"setSystemState(loaded)\""), std::string::npos);
+    EXPECT_NE(trace_json.find("\"name\":\"getProperties(/)\""), std::string::npos);
+    EXPECT_NE(trace_json.find("\"participant\":\"participant1\",\"detail\":\"test_config/parameter1\""), std::string::npos);
+
+    // without a sink nothing is collected
+    const auto span_count = trace_writer->getSpanCount();
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties));
+    EXPECT_EQ(trace_writer->getSpanCount(), span_count);
+}
+
+/**
+ * @detail Test the dry run printing the planned requests without changing the system
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemDryRun)
+{
+    test_file_properties.append("files/2_participants.fep_system_properties");
+    const auto state_before = system_to_test->getSystemState()._state;
+    controller::ConfigurationPlan plan;
+    controller::ConfigureOptions options;
+    options._plan = &plan;
+    options._dry_run = true;
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties, options));
+    EXPECT_EQ(system_to_test->getSystemState()._state, state_before);
+
+    ASSERT_EQ(plan._participants.size(), 2u);
+    EXPECT_EQ(plan._participants[0]._participant_name, part_name_1);
+    EXPECT_EQ(plan._participants[0]._system_property_count, 1u);
+    EXPECT_EQ(plan._participants[0]._element_property_count, 5u);
+    EXPECT_EQ(plan._timing_configuration_type, "Timing3ClockSyncOnlyInterpolation");
+    // node access and one request per property: (1 + 1) + (1 + 5) and (1 + 1) + (1 + 1)
+    EXPECT_EQ(controller::getRoundTripCount(plan), 12u);
+    std::ostringstream plan_text;
+    controller::writeConfigurationPlan(plan, plan_text);
+    EXPECT_NE(plan_text.str().find("12 round trips"), std::string::npos) << plan_text.str();
+
+    ASSERT_TRUE(setupPropertiesInterfaces());
+    EXPECT_NE(props_part1->getProperty("system/system_parameter"), "42");
+}
+
 /**
  * @brief Test whether properties having a preceeding '/' may be set and retrieved.
  * @req_id FEPSDK-2171
@@ -201,6 +513,41 @@ TEST_F(TesterControllerLibProperties, testConfigureSystemInvalidPropertyFormat)
     }
 }
 
+/**
+ * @brief Test whether failed properties are collected and retried instead of aborting the configuration
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemCollectFailures)
+{
+    test_file_properties.append("files/invalid_property_format.fep_system_properties");
+    controller::ConfigurationReport report;
+    controller::ConfigureOptions options;
+    options._report = &report;
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties, options));
+
+    ASSERT_EQ(report._failures.size(), 1u);
+    const auto& failure = report._failures.front();
+    EXPECT_EQ(failure._step, controller::ConfigurationStep::property);
+    EXPECT_EQ(failure._participant_name, part_name_1);
+    EXPECT_EQ(failure._node_path, "/");
+    EXPECT_EQ(failure._property_name, "test_config.parameter1");
+    EXPECT_EQ(failure._type, "int");
+    EXPECT_EQ(failure._value, "3");
+    EXPECT_NE(failure._reason.find("Error setting property 'test_config.parameter1' of participant 'participant1'."),
+              std::string::npos);
+
+    // the retry only sets the failed property, which fails again
+    controller::ConfigurationPlan plan;
+    options._retry_report = &report;
+    options._plan = &plan;
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties, options));
+    EXPECT_FALSE(plan._load_system);
+    EXPECT_FALSE(plan._configure_timing);
+    EXPECT_EQ(controller::getRoundTripCount(plan), 2u);
+    ASSERT_EQ(report._failures.size(), 1u);
+    EXPECT_EQ(report._failures.front()._property_name, "test_config.parameter1");
+}
+
 /**
  * @brief Test whether incorrect file name/path is reported as error
  * @req_id ""
@@ -276,6 +623,116 @@ TEST_F(TesterControllerLibProperties, testConfigureSystemDataModelParseError)
     }
 }
 
+/**
+ * @brief Test whether a system properties file parsed by the streaming parser is applied
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemStreamingParser)
+{
+    test_file_properties.append("files/2_participants.fep_system_properties");
+    controller::invalidateDescriptionCache();
+    controller::ConfigureOptions options;
+    options._streaming_parse_threshold = 0;
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties, options));
+    ASSERT_TRUE(setupPropertiesInterfaces());
+
+    EXPECT_EQ(a_util::strings::toDouble(props_part1->getProperty("test_config/pos1")), a_util::strings::toDouble("1.234"));
+    EXPECT_EQ(props_part1->getProperty("test_config/bool_value"), "true");
+    EXPECT_EQ(props_part1->getProperty("test_config/string_test"), "this is a string");
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "3");
+    EXPECT_EQ(props_part1->getProperty("system/system_parameter"), "42");
+    EXPECT_EQ(props_part2->getProperty("test_config/pos_X"), "100");
+    EXPECT_EQ(props_part2->getProperty("system/system_parameter"), "42");
+    EXPECT_EQ(props_part1->getProperty(FEP3_CLOCKSYNC_SERVICE_CONFIG_TIMING_MASTER), "participant2");
+}
+
+/**
+ * @brief Test whether the streaming parser drops whitespace-only values like the DOM based parser
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemStreamingParserWhitespaceValues)
+{
+    a_util::filesystem::Path test_file_whitespace = test_file_properties;
+    test_file_whitespace.append("files/whitespace_values.fep_system_properties");
+    test_file_properties.append("files/2_participants.fep_system_properties");
+
+    controller::invalidateDescriptionCache();
+    controller::ConfigureOptions streaming_options;
+    streaming_options._streaming_parse_threshold = 0;
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_whitespace, streaming_options));
+    ASSERT_TRUE(setupPropertiesInterfaces());
+    const std::string streamed_string = props_part1->getProperty("test_config/string_test");
+    const std::string streamed_system = props_part1->getProperty("system/system_parameter");
+
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_properties));
+    ASSERT_TRUE(setupPropertiesInterfaces());
+    ASSERT_EQ(props_part1->getProperty("test_config/string_test"), "this is a string");
+
+    controller::invalidateDescriptionCache();
+    ASSERT_NO_THROW(controller::configureSystemProperties(*system_to_test, test_file_whitespace));
+    ASSERT_TRUE(setupPropertiesInterfaces());
+    EXPECT_EQ(props_part1->getProperty("test_config/string_test"), streamed_string);
+    EXPECT_EQ(props_part1->getProperty("system/system_parameter"), streamed_system);
+    EXPECT_EQ(streamed_string, "");
+    EXPECT_EQ(streamed_system, "");
+}
+
+/**
+ * @brief Test whether the streaming parser reports incorrect XML syntax like the DOM based parser
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemStreamingParserXmlParseError)
+{
+    test_file_properties.append("files/xml_parse_error.fep_system_properties");
+    controller::ConfigureOptions options;
+    options._streaming_parse_threshold = 0;
+
+    try
+    {
+        fep3::controller::configureSystemProperties(*system_to_test, test_file_properties, options);
+        FAIL() << "Expected std::runtime_error";
+    }
+    catch (std::runtime_error const & err)
+    {
+        std::string error_what = err.what();
+        EXPECT_NE(error_what.find(std::string("xml_parse_error.fep_system_properties")), std::string::npos);
+        EXPECT_NE(error_what.find(std::string("xml parse error")), std::string::npos);
+        EXPECT_NE(error_what.find(std::string("Start-end tags mismatch")), std::string::npos);
+    }
+    catch (...)
+    {
+        FAIL() << "Expected std::runtime_error";
+    }
+}
+
+/**
+ * @brief Test whether the streaming parser reports data model errors like the DOM based parser
+ * @req_id ""
+ */
+TEST_F(TesterControllerLibProperties, testConfigureSystemStreamingParserDataModelParseError)
+{
+    test_file_properties.append("files/data_model_parse_error.fep_system_properties");
+    controller::ConfigureOptions options;
+    options._streaming_parse_threshold = 0;
+
+    try
+    {
+        fep3::controller::configureSystemProperties(*system_to_test, test_file_properties, options);
+        FAIL() << "Expected std::runtime_error";
+    }
+    catch (std::runtime_error const & err)
+    {
+        std::string error_what = err.what();
+        EXPECT_NE(error_what.find(std::string("data_model_parse_error.fep_system_properties")), std::string::npos);
+        EXPECT_NE(error_what.find(std::string("fep sdk system properties data model parse error")), std::string::npos);
+        EXPECT_NE(error_what.find(std::string("element \"properties\" not found")), std::string::npos);
+    }
+    catch (...)
+    {
+        FAIL() << "Expected std::runtime_error";
+    }
+}
+
  /**
   * @req_id ""
   */
@@ -29,6 +29,7 @@
 
 #include <gtest/gtest.h>
 #include <fep_controller/fep_controller.h>
+#include <fep_controller/system_batch.h>
 #include <fep_system/fep_system.h>
 #include <a_util/system.h>
 #include <a_util/xml.h>
@@ -37,11 +38,13 @@
 #include <fep3/core/participant.h>
 #include <fep3/components/configuration/propertynode_helper.h>
 #include <fep3/components/configuration/propertynode.h>
+#include <fep3/components/configuration/configuration_service_intf.h>
 
 #include <string>
 #include <memory>
 
 #include "fep_test_common.h"
+#include "system_generator.h"
 
 /**
  * Test base functionality
@@ -79,6 +82,191 @@ TEST(TesterControllerLib, testConnectSystem)
     system_to_test->shutdown();
 }
 
+/**
+ * @brief Test whether a system sdk description is parsed only once if it did not change
+ * @req_id ""
+ */
+TEST(TesterControllerLib, testConnectSystemDescriptionCache)
+{
+    const std::vector<std::string> participant_names{ "participant1", "participant2" };
+    auto lst_parts = createTestParticipants(participant_names, "FEP_SYSTEM");
+
+    a_util::filesystem::Path test_file(TESTFILES_DIR);
+    test_file.append("files/2_participants.fep_sdk_system");
+
+    fep3::controller::invalidateDescriptionCache();
+    const auto statistics_before = fep3::controller::getDescriptionCacheStatistics();
+    EXPECT_EQ(statistics_before._entries, 0u);
+
+    ASSERT_NO_THROW(fep3::controller::connectSystem(test_file));
+    ASSERT_NO_THROW(fep3::controller::connectSystem(test_file));
+    auto statistics = fep3::controller::getDescriptionCacheStatistics();
+    EXPECT_EQ(statistics._entries, 1u);
+    EXPECT_EQ(statistics._misses, statistics_before._misses + 1);
+    EXPECT_EQ(statistics._hits, statistics_before._hits + 1);
+    EXPECT_GT(statistics._memory_usage, 0u);
+
+    fep3::controller::invalidateDescriptionCache(test_file);
+    EXPECT_EQ(fep3::controller::getDescriptionCacheStatistics()._entries, 0u);
+
+    // a disabled cache keeps nothing
+    fep3::controller::setDescriptionCacheLimit(0);
+    std::unique_ptr<fep3::System> system_to_test;
+    ASSERT_NO_THROW(system_to_test = std::make_unique<fep3::System>(
+        fep3::controller::connectSystem(test_file)));
+    EXPECT_EQ(fep3::controller::getDescriptionCacheStatistics()._entries, 0u);
+    EXPECT_EQ(system_to_test->getParticipants().size(), 2u);
+    fep3::controller::setDescriptionCacheLimit(fep3::controller::description_cache_default_memory_limit);
+
+    system_to_test->shutdown();
+}
+
+/**
+ * @detail Test the asynchronous connect with progress reporting and cancellation
+ * @req_id ""
+ */
+TEST(TesterControllerLib, testConnectSystemAsync)
+{
+    const std::vector<std::string> participant_names{ "participant1", "participant2" };
+    auto lst_parts = createTestParticipants(participant_names, "FEP_SYSTEM");
+
+    a_util::filesystem::Path test_file(TESTFILES_DIR);
+    test_file.append("files/2_participants.fep_sdk_system");
+
+    std::vector<std::string> connected;
+    size_t parsed_count = 0;
+    fep3::controller::ConnectOptions options;
+    options._progress_callback = [&](fep3::controller::ProgressStage stage, const std::string& participant_name)
+    {
+        if (stage == fep3::controller::ProgressStage::parsed)
+        {
+            ++parsed_count;
+        }
+        else if (stage == fep3::controller::ProgressStage::connected)
+        {
+            connected.push_back(participant_name);
+        }
+    };
+    auto connecting = fep3::controller::connectSystemAsync(test_file, options);
+    std::unique_ptr<fep3::System> system_to_test;
+    ASSERT_NO_THROW(system_to_test = std::make_unique<fep3::System>(connecting.get()));
+    EXPECT_EQ(system_to_test->getParticipants().size(), 2u);
+    EXPECT_EQ(parsed_count, 1u);
+    EXPECT_EQ(connected, participant_names);
+    system_to_test->shutdown();
+
+    fep3::controller::ConnectOptions cancelled_options;
+    cancelled_options._cancellation_token.cancel();
+    auto cancelled = fep3::controller::connectSystemAsync(test_file, cancelled_options);
+    EXPECT_THROW(cancelled.get(), fep3::controller::OperationCancelledError);
+}
+
+/**
+ * @detail Test the connection to a large generated system
+ * @req_id ""
+ */
+TEST(TesterControllerLib, testConnectSystemGenerated)
+{
+    fep3::controller::test::SystemGeneratorOptions options;
+    options._participant_count = 500;
+    options._property_count = 0;
+    options._timing_file_count = 3;
+    options._mapping_file_count = 2;
+    options._priority_levels = 5;
+    const auto files = fep3::controller::test::generateSystemFiles(options, GENERATED_FILES_DIR, "connect_generated");
+
+    std::unique_ptr<fep3::System> system_to_test;
+    ASSERT_NO_THROW(system_to_test = std::make_unique<fep3::System>(
+        fep3::controller::connectSystem(files._system_description_file)));
+    ASSERT_EQ(system_to_test->getSystemName(), options._system_name);
+
+    const auto participants = system_to_test->getParticipants();
+    ASSERT_EQ(participants.size(), options._participant_count);
+    const auto& last_participant = participants.back();
+    EXPECT_EQ(last_participant.getName(), fep3::controller::test::getGeneratedParticipantName(499));
+    EXPECT_EQ(last_participant.getInitPriority(), 4);
+    const std::string timing_file_reference = last_participant.getAdditionalInfo("timing_file_reference", "");
+    EXPECT_NE(timing_file_reference.find("timing/timing_1.xml"), std::string::npos) << timing_file_reference;
+    const std::string input_mapping = last_participant.getAdditionalInfo("input_mapping", "");
+    EXPECT_NE(input_mapping.find("mapping/input_1.map"), std::string::npos) << input_mapping;
+}
+
+/**
+ * @detail Test that shared file references are resolved once and stay available
+ * @req_id ""
+ */
+TEST(TesterControllerLib, testConnectSystemResolvedPaths)
+{
+    fep3::controller::test::SystemGeneratorOptions options;
+    options._participant_count = 100;
+    options._property_count = 0;
+    options._timing_file_count = 3;
+    options._mapping_file_count = 2;
+    const auto files = fep3::controller::test::generateSystemFiles(options, GENERATED_FILES_DIR, "connect_resolved_paths");
+
+    fep3::controller::ResolvedPaths resolved_paths;
+    fep3::controller::ConnectOptions connect_options;
+    connect_options._resolved_paths = &resolved_paths;
+    std::unique_ptr<fep3::System> system_to_test;
+    ASSERT_NO_THROW(system_to_test = std::make_unique<fep3::System>(
+        fep3::controller::connectSystem(files._system_description_file, connect_options)));
+
+    // 3 timing files, 2 input and 2 output mappings
+    EXPECT_EQ(resolved_paths.size(), 7u);
+    const auto system_directory = a_util::filesystem::Path(files._system_description_file).getParent().toString();
+    const auto resolved_timing = resolved_paths.find("timing/timing_0.xml", system_directory);
+    ASSERT_NE(resolved_timing, nullptr);
+    EXPECT_EQ(*resolved_timing,
+              system_to_test->getParticipant("participant_0").getAdditionalInfo("timing_file_reference", ""));
+
+    // connecting again reuses the resolved paths
+    ASSERT_NO_THROW(fep3::controller::connectSystem(files._system_description_file, connect_options));
+    EXPECT_EQ(resolved_paths.size(), 7u);
+}
+
+/**
+ * @detail Test the connection to a system described by a snapshot
+ * @req_id ""
+ */
+TEST(TesterControllerLib, testConnectSystemSnapshot)
+{
+    fep3::controller::test::SystemGeneratorOptions options;
+    options._participant_count = 100;
+    options._property_count = 0;
+    options._timing_file_count = 3;
+    options._mapping_file_count = 2;
+    options._priority_levels = 5;
+    const auto files = fep3::controller::test::generateSystemFiles(options, GENERATED_FILES_DIR, "connect_snapshot");
+    // next to the description, the relative file references stay valid
+    const auto snapshot_file = files._system_description_file + "." + fep3::controller::snapshot_file_extension;
+    ASSERT_NO_THROW(fep3::controller::convertSystemDescriptionToSnapshot(files._system_description_file, snapshot_file));
+
+    std::unique_ptr<fep3::System> system_to_test;
+    ASSERT_NO_THROW(system_to_test = std::make_unique<fep3::System>(
+        fep3::controller::connectSystem(snapshot_file)));
+    const auto expected_system = fep3::controller::connectSystem(files._system_description_file);
+    ASSERT_EQ(system_to_test->getSystemName(), expected_system.getSystemName());
+
+    const auto participants = system_to_test->getParticipants();
+    const auto expected_participants = expected_system.getParticipants();
+    ASSERT_EQ(participants.size(), expected_participants.size());
+    for (size_t index = 0; index < participants.size(); ++index)
+    {
+        EXPECT_EQ(participants[index].getName(), expected_participants[index].getName());
+        EXPECT_EQ(participants[index].getInitPriority(), expected_participants[index].getInitPriority());
+        EXPECT_EQ(participants[index].getAdditionalInfo("timing_file_reference", ""),
+                  expected_participants[index].getAdditionalInfo("timing_file_reference", ""));
+        EXPECT_EQ(participants[index].getAdditionalInfo("input_mapping", ""),
+                  expected_participants[index].getAdditionalInfo("input_mapping", ""));
+    }
+
+    // a snapshot of the properties is no system description
+    const auto properties_snapshot_file = files._system_properties_file + "." + fep3::controller::snapshot_file_extension;
+    ASSERT_NO_THROW(fep3::controller::convertSystemPropertiesToSnapshot(files._system_properties_file,
+                                                                       properties_snapshot_file));
+    EXPECT_THROW(fep3::controller::connectSystem(properties_snapshot_file), std::runtime_error);
+}
+
 /**
  * @brief Test whether incorrect file name/path is reported as error
  * @req_id ""
@@ -154,4 +342,102 @@ TEST(TesterControllerLib, testConnectSystemDataModelParseError)
     {
         FAIL() << "Expected std::runtime_error";
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @detail Test the connect and configuration of a system in one go
+ * @req_id ""
+ */
+TEST(TesterControllerLib, testBringUpSystem)
+{
+    const std::vector<std::string> participant_names{ "participant1", "participant2" };
+    auto lst_parts = createTestParticipants(participant_names, "FEP_SYSTEM");
+
+    a_util::filesystem::Path test_file_system(TESTFILES_DIR);
+    test_file_system.append("files/2_participants.fep_sdk_system");
+    a_util::filesystem::Path test_file_properties(TESTFILES_DIR);
+    test_file_properties.append("files/2_participants.fep_system_properties");
+
+    std::vector<std::string> loaded;
+    std::vector<std::string> configured;
+    fep3::controller::BringUpOptions options;
+    options._configure_options._progress_callback =
+        [&](fep3::controller::ProgressStage stage, const std::string& participant_name)
+        {
+            if (stage == fep3::controller::ProgressStage::loaded)
+            {
+                loaded.push_back(participant_name);
+            }
+            else if (stage == fep3::controller::ProgressStage::configured)
+            {
+                configured.push_back(participant_name);
+            }
+        };
+    std::unique_ptr<fep3::System> system_to_test;
+    ASSERT_NO_THROW(system_to_test = std::make_unique<fep3::System>(
+        fep3::controller::bringUpSystem(test_file_system, test_file_properties, options)));
+    EXPECT_EQ(loaded, participant_names);
+    EXPECT_EQ(configured, participant_names);
+
+    const auto system_state = system_to_test->getSystemState();
+    EXPECT_EQ(system_state._state, fep3::SystemAggregatedState::loaded);
+    EXPECT_TRUE(system_state._homogeneous);
+    auto props_part1 = system_to_test->getParticipant("participant1")
+        .getRPCComponentProxyByIID<fep3::rpc::IRPCConfiguration>()->getProperties("/");
+    ASSERT_TRUE(props_part1);
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "3");
+    EXPECT_EQ(props_part1->getProperty("system/system_parameter"), "42");
+
+    system_to_test->shutdown();
+}
+
+/**
+ * @detail Test bringing up several systems from one process
+ * @req_id ""
+ */
+TEST(TesterControllerLib, testBringUpSystems)
+{
+    const std::vector<std::string> participant_names{ "participant1", "participant2" };
+    auto lst_parts = createTestParticipants(participant_names, "FEP_SYSTEM");
+
+    a_util::filesystem::Path test_file_system(TESTFILES_DIR);
+    test_file_system.append("files/2_participants.fep_sdk_system");
+    a_util::filesystem::Path test_file_properties(TESTFILES_DIR);
+    test_file_properties.append("files/2_participants.fep_system_properties");
+
+    // two jobs share the parsed files, the third one fails on its missing properties file
+    const std::vector<fep3::controller::SystemJob> jobs{
+        { test_file_system, test_file_properties },
+        { test_file_system, test_file_properties },
+        { test_file_system, "file_does_not_exist" } };
+    std::vector<size_t> completed;
+    fep3::controller::BatchOptions options;
+    options._worker_count = 2;
+    // the third job waits for one of the others
+    options._job_count = 2;
+    options._result_callback = [&completed](fep3::controller::SystemJobResult& result)
+    {
+        completed.push_back(result._job_index);
+    };
+    std::vector<fep3::controller::SystemJobResult> results;
+    ASSERT_NO_THROW(results = fep3::controller::bringUpSystems(jobs, options));
+    ASSERT_EQ(results.size(), jobs.size());
+    EXPECT_EQ(completed.size(), jobs.size());
+
+    for (size_t index = 0; index < 2; ++index)
+    {
+        EXPECT_EQ(results[index]._job_index, index);
+        EXPECT_TRUE(results[index]._error_message.empty()) << results[index]._error_message;
+        ASSERT_TRUE(results[index]._system);
+        EXPECT_EQ(results[index]._system->getSystemState()._state, fep3::SystemAggregatedState::loaded);
+    }
+    EXPECT_FALSE(results[2]._error_message.empty());
+    EXPECT_FALSE(results[2]._system);
+
+    auto props_part1 = results[0]._system->getParticipant("participant1")
+        .getRPCComponentProxyByIID<fep3::rpc::IRPCConfiguration>()->getProperties("/");
+    ASSERT_TRUE(props_part1);
+    EXPECT_EQ(props_part1->getProperty("system/system_parameter"), "42");
+
+    results[0]._system->shutdown();
+}
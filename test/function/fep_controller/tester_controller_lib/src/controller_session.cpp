@@ -0,0 +1,135 @@
+/**
+
+   @copyright
+   @verbatim
+   Copyright @ 2019 Audi AG. All rights reserved.
+   
+       This Source Code Form is subject to the terms of the Mozilla
+       Public License, v. 2.0. If a copy of the MPL was not distributed
+       with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+   
+   If it is not possible or desirable to put the notice in a particular file, then
+   You may include the notice in a location (such as a LICENSE file in a
+   relevant directory) where a recipient would be likely to look for such a notice.
+   
+   You may add additional accurate notices of copyright ownership.
+   @endverbatim
+ */
+
+ /**
+ * Test Case:   TestControllerSession
+ * Test ID:     1.0
+ * Test Title:  FEP Controller session test
+ * Description: Test if a test system can be controlled by one session from connect to teardown
+ * Strategy:    Connect, configure, reconfigure and tear down a system via the Controller
+ * Passed If:   no errors occur
+ * Ticket:      -
+ * Requirement: -
+ */
+
+#include <gtest/gtest.h>
+#include <fep_controller/controller.h>
+#include <fep_system/fep_system.h>
+#include <a_util/filesystem.h>
+
+#include <fep3/core/participant.h>
+#include <fep3/components/configuration/configuration_service_intf.h>
+#include "fep_test_common.h"
+
+#include <string>
+#include <memory>
+
+using namespace fep3;
+
+class TesterControllerSession : public ::testing::Test
+{
+protected:
+    const std::string part_name_1 = "participant1";
+    const std::string part_name_2 = "participant2";
+    a_util::filesystem::Path test_file_system{ TESTFILES_DIR };
+    a_util::filesystem::Path test_file_properties{ TESTFILES_DIR };
+
+private:
+    TestParticipants lst_parts;
+
+protected:
+    void SetUp()
+    {
+        const std::vector<std::string> participant_names{ part_name_1, part_name_2 };
+        lst_parts = createTestParticipants(participant_names, "FEP_SYSTEM");
+        test_file_system.append("files/2_participants.fep_sdk_system");
+        test_file_properties.append("files/2_participants.fep_system_properties");
+    }
+
+    std::shared_ptr<fep3::IProperties> getProperties(controller::Controller& session,
+                                                     const std::string& participant_name)
+    {
+        return session.getSystem().getParticipant(participant_name)
+            .getRPCComponentProxyByIID<fep3::rpc::IRPCConfiguration>()->getProperties("/");
+    }
+
+    fep3::rpc::IRPCParticipantStateMachine::State getState(controller::Controller& session,
+                                                           const std::string& participant_name)
+    {
+        return session.getSystem().getParticipant(participant_name)
+            .getRPCComponentProxyByIID<fep3::rpc::IRPCParticipantStateMachine>()->getState();
+    }
+};
+
+/**
+ * @brief Test a session from connect to teardown
+ * @req_id ""
+ */
+TEST_F(TesterControllerSession, testControllerSession)
+{
+    controller::Controller session;
+    EXPECT_FALSE(session.isConnected());
+    ASSERT_NO_THROW(session.connect(test_file_system));
+    ASSERT_TRUE(session.isConnected());
+    EXPECT_EQ(session.getSystem().getSystemName(), "FEP_SYSTEM");
+
+    ASSERT_NO_THROW(session.configure(test_file_properties));
+    auto props_part1 = getProperties(session, part_name_1);
+    ASSERT_TRUE(props_part1);
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "3");
+    // 1 system property and 5 participant properties
+    EXPECT_EQ(session.getAppliedProperties().getPropertyCount(part_name_1), 6u);
+    EXPECT_EQ(getState(session, part_name_1), fep3::rpc::IRPCParticipantStateMachine::State::loaded);
+
+    // a reconfigure with the same file does not touch the participants
+    ASSERT_TRUE(props_part1->setProperty("test_config/parameter1", "7", "int"));
+    ASSERT_NO_THROW(session.reconfigure(test_file_properties));
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "7");
+
+    // a configure pushes everything again
+    ASSERT_NO_THROW(session.configure(test_file_properties));
+    EXPECT_EQ(props_part1->getProperty("test_config/parameter1"), "3");
+
+    ASSERT_NO_THROW(session.teardown());
+    EXPECT_FALSE(session.isConnected());
+    EXPECT_TRUE(session.getAppliedProperties().empty());
+
+    // the session may be connected again, the participants were unloaded by the teardown
+    ASSERT_NO_THROW(session.connect(test_file_system));
+    EXPECT_EQ(getState(session, part_name_1), fep3::rpc::IRPCParticipantStateMachine::State::unloaded);
+    EXPECT_EQ(getState(session, part_name_2), fep3::rpc::IRPCParticipantStateMachine::State::unloaded);
+    session.getSystem().shutdown();
+}
+
+/**
+ * @brief Test the failures of a session used in the wrong order
+ * @req_id ""
+ */
+TEST_F(TesterControllerSession, testControllerSessionNotConnected)
+{
+    controller::Controller session;
+    EXPECT_THROW(session.configure(test_file_properties), std::runtime_error);
+    EXPECT_THROW(session.reconfigure(test_file_properties), std::runtime_error);
+    EXPECT_THROW(session.getSystem(), std::runtime_error);
+    EXPECT_NO_THROW(session.teardown());
+
+    ASSERT_NO_THROW(session.connect(test_file_system));
+    EXPECT_THROW(session.connect(test_file_system), std::runtime_error);
+    EXPECT_EQ(session.getSystem().getSystemName(), "FEP_SYSTEM");
+    session.getSystem().shutdown();
+}